@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>   // std::equal, std::fill
+#include <compare>     // std::strong_ordering
+#include <cstddef>     // size_t
+#include <iterator>    // std::reverse_iterator
+#include <type_traits>
+#include <utility>     // std::swap
+
+#include "Array.hpp"
+
+#ifndef _LIBPOWERCXX_CACHE_LINE_SIZE
+    // std::hardware_destructive_interference_size varies with -mtune, so a header type
+    // built on it changes layout between translation units; pass it as Align instead
+    #define _LIBPOWERCXX_CACHE_LINE_SIZE 64
+#endif
+
+inline constexpr std::size_t kCacheLineSize = _LIBPOWERCXX_CACHE_LINE_SIZE;
+
+enum class ArrayPadding
+{
+    None,         // elements packed as in Array; only the whole array is aligned
+    PerElement,   // every element starts its own Align-byte slot
+};
+
+/// One element of a padded AlignedArray, alone in Align bytes (or a multiple of them).
+template<typename T, std::size_t Align>
+struct alignas(Align) PaddedSlot
+{
+    T value;
+};
+
+/// Random-access iterator over the elements of consecutive PaddedSlots: a pointer that
+/// steps sizeof(Slot) bytes at a time and dereferences to the element inside.
+template<typename Slot, bool Const>
+struct StridedIterator
+{
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = decltype(Slot::value);
+    using difference_type   = std::ptrdiff_t;
+    using pointer   = std::conditional_t<Const, const value_type *, value_type *>;
+    using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+  private:
+    using SlotPtr = std::conditional_t<Const, const Slot *, Slot *>;
+
+    SlotPtr mSlot = nullptr;
+
+    template<typename, std::size_t, std::size_t, ArrayPadding>
+    friend struct AlignedArray;
+
+    constexpr explicit StridedIterator(SlotPtr slot) noexcept : mSlot(slot) { }
+
+  public:
+    /// Bytes between consecutive elements.
+    static constexpr std::size_t stride = sizeof(Slot);
+
+    constexpr StridedIterator() = default;
+
+    // iterator -> const_iterator
+    template<bool C = Const>
+        requires C
+    constexpr StridedIterator(const StridedIterator<Slot, false> &that) noexcept
+        : mSlot(that.mSlot)
+    { }
+
+    constexpr reference operator*() const noexcept { return mSlot->value; }
+
+    constexpr pointer operator->() const noexcept { return &mSlot->value; }
+
+    constexpr reference operator[](difference_type n) const noexcept
+    {
+        return mSlot[n].value;
+    }
+
+    // ++iterator
+    constexpr StridedIterator &operator++() noexcept
+    {
+        ++mSlot;
+        return *this;
+    }
+
+    // iterator++
+    constexpr StridedIterator operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++mSlot;
+        return tmp;
+    }
+
+    // --iterator
+    constexpr StridedIterator &operator--() noexcept
+    {
+        --mSlot;
+        return *this;
+    }
+
+    // iterator--
+    constexpr StridedIterator operator--(int) noexcept
+    {
+        auto tmp = *this;
+        --mSlot;
+        return tmp;
+    }
+
+    constexpr StridedIterator &operator+=(difference_type n) noexcept
+    {
+        mSlot += n;
+        return *this;
+    }
+
+    constexpr StridedIterator &operator-=(difference_type n) noexcept
+    {
+        mSlot -= n;
+        return *this;
+    }
+
+    constexpr StridedIterator operator+(difference_type n) const noexcept
+    {
+        return StridedIterator(mSlot + n);
+    }
+
+    friend constexpr StridedIterator operator+(difference_type n,
+                                               StridedIterator it) noexcept
+    {
+        return it + n;
+    }
+
+    constexpr StridedIterator operator-(difference_type n) const noexcept
+    {
+        return StridedIterator(mSlot - n);
+    }
+
+    constexpr difference_type operator-(const StridedIterator &that) const noexcept
+    {
+        return mSlot - that.mSlot;
+    }
+
+    constexpr bool operator==(const StridedIterator &that) const noexcept
+    {
+        return mSlot == that.mSlot;
+    }
+
+    constexpr auto operator<=>(const StridedIterator &that) const noexcept
+    {
+        return mSlot <=> that.mSlot;
+    }
+
+    friend StridedIterator<Slot, !Const>;
+};
+
+/// Array of N elements aligned to Align bytes. With ArrayPadding::PerElement every
+/// element also gets its own Align-byte slot, so elements written by different
+/// threads, such as per-thread counters, never share a cache line and a write never
+/// steals the line from another core. Align 128 also keeps apart the line pairs that
+/// x86's adjacent-line prefetcher fetches together.
+///
+/// Unpadded, it is an Array with a stronger alignment: iterators and data() are T *.
+/// Padded, iterators and data() are StridedIterators that index, step and compare like
+/// T *, but move sizeof(PaddedSlot) bytes per element; stride() gives that distance.
+template<typename T, std::size_t N, std::size_t Align = kCacheLineSize,
+         ArrayPadding Padding = ArrayPadding::None>
+struct AlignedArray
+{
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0 && Align >= alignof(T),
+                  "Align must be a power of two no smaller than alignof(T)");
+    static_assert(N != 0, "AlignedArray needs at least one element");
+
+    static constexpr bool kPadded = Padding == ArrayPadding::PerElement;
+
+    using Slot = std::conditional_t<kPadded, PaddedSlot<T, Align>, T>;
+
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T &;
+    using const_reference = const T &;
+    using iterator  = std::conditional_t<kPadded, StridedIterator<Slot, false>, T *>;
+    using const_iterator =
+            std::conditional_t<kPadded, StridedIterator<Slot, true>, const T *>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    alignas(Align) Slot m_elements[N];
+
+    /// Bytes between consecutive elements.
+    static constexpr std::size_t stride() noexcept { return sizeof(Slot); }
+
+    constexpr T &operator[](std::size_t i) noexcept { return element(m_elements[i]); }
+
+    constexpr const T &operator[](std::size_t i) const noexcept
+    {
+        return element(m_elements[i]);
+    }
+
+    constexpr T &at(std::size_t i)
+    {
+        if (i >= N) [[unlikely]]
+            _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, N);
+        return (*this)[i];
+    }
+
+    constexpr const T &at(std::size_t i) const
+    {
+        if (i >= N) [[unlikely]]
+            _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, N);
+        return (*this)[i];
+    }
+
+    constexpr void fill(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>)
+    {
+        std::fill(begin(), end(), value);
+    }
+
+    constexpr void swap(AlignedArray &that) noexcept(std::is_nothrow_swappable_v<T>)
+    {
+        for (std::size_t i = 0; i < N; i++)
+            std::swap((*this)[i], that[i]);
+    }
+
+    constexpr T &front() noexcept { return (*this)[0]; }
+
+    constexpr const T &front() const noexcept { return (*this)[0]; }
+
+    constexpr T &back() noexcept { return (*this)[N - 1]; }
+
+    constexpr const T &back() const noexcept { return (*this)[N - 1]; }
+
+    static constexpr bool empty() noexcept { return false; }
+
+    static constexpr std::size_t size() noexcept { return N; }
+
+    static constexpr std::size_t max_size() noexcept { return N; }
+
+    constexpr iterator data() noexcept { return begin(); }
+
+    constexpr const_iterator data() const noexcept { return begin(); }
+
+    constexpr const_iterator cdata() const noexcept { return begin(); }
+
+    constexpr iterator begin() noexcept { return iterator(m_elements); }
+
+    constexpr iterator end() noexcept { return iterator(m_elements + N); }
+
+    constexpr const_iterator begin() const noexcept { return const_iterator(m_elements); }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return const_iterator(m_elements + N);
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+    constexpr const_iterator cend() const noexcept { return end(); }
+
+    constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    constexpr const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    constexpr const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+    constexpr bool operator==(const AlignedArray &that) const
+    {
+        return std::equal(begin(), end(), that.begin());
+    }
+
+  private:
+    static constexpr T &element(Slot &slot) noexcept
+    {
+        if constexpr (kPadded)
+            return slot.value;
+        else
+            return slot;
+    }
+
+    static constexpr const T &element(const Slot &slot) noexcept
+    {
+        if constexpr (kPadded)
+            return slot.value;
+        else
+            return slot;
+    }
+};
+
+/// AlignedArray with every element on its own Align-byte slot.
+template<typename T, std::size_t N, std::size_t Align = kCacheLineSize>
+using PaddedArray = AlignedArray<T, N, Align, ArrayPadding::PerElement>;
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <algorithm>   // std::sort, std::lower_bound
+#include <compare>     // std::strong_ordering
 #include <cstddef>     // size_t
+#include <functional>  // std::less
 #include <iterator>    // std::reverse_iterator
 #include <stdexcept>   // std::runtime_error
 #include <string>      // std::to_string
 #include <type_traits>
+#include <utility>     // std::pair
+
+#include "SimdSearch.hpp"
 
 
 #define _LIBPOWERCXX_THROW_OUT_OF_RANGE(__i, __n)                             \
@@ -39,43 +45,55 @@ class Array
 
     T m_elements[N];
 
-    T &operator[](std::size_t i) noexcept { return m_elements[i]; }
+    /// Assign an expression from ArrayExpr.hpp, evaluated straight into the elements.
+    template<typename E>
+        requires requires(const E &expr, T *dst) {
+            expr.evalInto(dst);
+            requires E::size() == N;
+        }
+    Array &operator=(const E &expr) noexcept
+    {
+        expr.evalInto(m_elements);
+        return *this;
+    }
 
-    const T &operator[](std::size_t i) const noexcept { return m_elements[i]; }
+    constexpr T &operator[](std::size_t i) noexcept { return m_elements[i]; }
 
-    T &at(std::size_t i)
+    constexpr const T &operator[](std::size_t i) const noexcept { return m_elements[i]; }
+
+    constexpr T &at(std::size_t i)
     {
         if (i >= N) [[unlikely]]
             _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, N);
         return m_elements[i];
     }
 
-    const T &at(std::size_t i) const
+    constexpr const T &at(std::size_t i) const
     {
         if (i >= N) [[unlikely]]
             _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, N);
         return m_elements[i];
     }
 
-    void fill(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>)
+    constexpr void fill(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>)
     {
         for (std::size_t i = 0; i < N; i++)
             m_elements[i] = value;
     }
 
-    void swap(Array &that) noexcept(std::is_nothrow_swappable_v<T>)
+    constexpr void swap(Array &that) noexcept(std::is_nothrow_swappable_v<T>)
     {
         for (std::size_t i = 0; i < N; i++)
             std::swap(m_elements[i], that.m_elements[i]);
     }
 
-    T &front() noexcept { return m_elements[0]; }
+    constexpr T &front() noexcept { return m_elements[0]; }
 
-    const T &front() const noexcept { return m_elements[0]; }
+    constexpr const T &front() const noexcept { return m_elements[0]; }
 
-    T &back() noexcept { return m_elements[N - 1]; }
+    constexpr T &back() noexcept { return m_elements[N - 1]; }
 
-    const T &back() const noexcept { return m_elements[N - 1]; }
+    constexpr const T &back() const noexcept { return m_elements[N - 1]; }
 
     static constexpr std::size_t empty() noexcept { return false; }
 
@@ -83,50 +101,134 @@ class Array
 
     static constexpr std::size_t max_size() noexcept { return N; }
 
-    T *data() noexcept { return m_elements; }
-
-    const T *data() const noexcept { return m_elements; }
+    constexpr T *data() noexcept { return m_elements; }
 
-    const T *cdata() const noexcept { return m_elements; }
+    constexpr const T *data() const noexcept { return m_elements; }
 
-    T *begin() noexcept { return m_elements; }
+    constexpr const T *cdata() const noexcept { return m_elements; }
 
-    T *end() noexcept { return m_elements + N; }
+    constexpr T *begin() noexcept { return m_elements; }
 
-    const T *begin() const noexcept { return m_elements; }
+    constexpr T *end() noexcept { return m_elements + N; }
 
-    const T *end() const noexcept { return m_elements + N; }
+    constexpr const T *begin() const noexcept { return m_elements; }
 
-    const T *cbegin() const noexcept { return m_elements; }
+    constexpr const T *end() const noexcept { return m_elements + N; }
 
-    const T *cend() const noexcept { return m_elements + N; }
+    constexpr const T *cbegin() const noexcept { return m_elements; }
 
-    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(m_elements); }
+    constexpr const T *cend() const noexcept { return m_elements + N; }
 
-    reverse_iterator rend() noexcept
+    // a reverse iterator dereferences the element before the one it wraps
+    constexpr reverse_iterator rbegin() noexcept
     {
         return std::make_reverse_iterator(m_elements + N);
     }
 
-    const_reverse_iterator rbegin() const noexcept
+    constexpr reverse_iterator rend() noexcept
     {
         return std::make_reverse_iterator(m_elements);
     }
 
-    const_reverse_iterator rend() const noexcept
+    constexpr const_reverse_iterator rbegin() const noexcept
     {
         return std::make_reverse_iterator(m_elements + N);
     }
 
-    const_reverse_iterator crbegin() const noexcept
+    constexpr const_reverse_iterator rend() const noexcept
     {
         return std::make_reverse_iterator(m_elements);
     }
 
-    const_reverse_iterator crend() const noexcept
+    constexpr const_reverse_iterator crbegin() const noexcept
     {
         return std::make_reverse_iterator(m_elements + N);
     }
+
+    constexpr const_reverse_iterator crend() const noexcept
+    {
+        return std::make_reverse_iterator(m_elements);
+    }
+
+    constexpr T *find(const T &value) noexcept(isNothrowSearchable<T>)
+    {
+        return m_elements + simdFind(m_elements, N, value);
+    }
+
+    constexpr const T *find(const T &value) const noexcept(isNothrowSearchable<T>)
+    {
+        return m_elements + simdFind(m_elements, N, value);
+    }
+
+    constexpr std::size_t count(const T &value) const noexcept(isNothrowSearchable<T>)
+    {
+        return simdCount(m_elements, N, value);
+    }
+
+    constexpr bool contains(const T &value) const noexcept(isNothrowSearchable<T>)
+    {
+        return simdFind(m_elements, N, value) != N;
+    }
+
+    template<typename Compare = std::less<>>
+    constexpr void sort(Compare comp = Compare())
+    {
+        std::sort(m_elements, m_elements + N, comp);
+    }
+
+    /// First element not ordered before value; the Array must be sorted by comp.
+    template<typename U, typename Compare = std::less<>>
+    constexpr T *lower_bound(const U &value, Compare comp = Compare())
+    {
+        return std::lower_bound(m_elements, m_elements + N, value, comp);
+    }
+
+    template<typename U, typename Compare = std::less<>>
+    constexpr const T *lower_bound(const U &value, Compare comp = Compare()) const
+    {
+        return std::lower_bound(m_elements, m_elements + N, value, comp);
+    }
+
+    /// Assign fn(i) to element i, or fn() in order when fn takes no index.
+    template<typename Fn>
+    constexpr void generate(Fn fn)
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            if constexpr (std::is_invocable_v<Fn &, std::size_t>)
+                m_elements[i] = fn(i);
+            else
+                m_elements[i] = fn();
+        }
+    }
+
+    constexpr bool equal(const Array &that) const noexcept(isNothrowSearchable<T>)
+    {
+        return simdEqual(m_elements, N, that.m_elements, N);
+    }
+
+    constexpr std::pair<const T *, const T *> mismatch(const Array &that) const
+            noexcept(isNothrowSearchable<T>)
+    {
+        std::size_t i = simdMismatch(m_elements, that.m_elements, N);
+        return {m_elements + i, that.m_elements + i};
+    }
+
+    constexpr auto compare(const Array &that) const noexcept(isNothrowComparable<T>)
+    {
+        return simdCompareThreeWay(m_elements, N, that.m_elements, N);
+    }
+
+    constexpr bool operator==(const Array &that) const noexcept(isNothrowSearchable<T>)
+    {
+        return equal(that);
+    }
+
+    constexpr auto operator<=>(const Array &that) const
+            noexcept(isNothrowComparable<T>)
+    {
+        return compare(that);
+    }
 };
 
 template<typename T>
@@ -143,25 +245,28 @@ class Array<T, 0>
     using reverse_iterator       = std::reverse_iterator<T *>;
     using const_reverse_iterator = std::reverse_iterator<const T *>;
 
-    T &operator[](std::size_t i) noexcept { _LIBPOWERCXX_UNREACHABLE(); }
+    constexpr T &operator[](std::size_t i) noexcept { _LIBPOWERCXX_UNREACHABLE(); }
 
-    const T &operator[](std::size_t i) const noexcept { _LIBPOWERCXX_UNREACHABLE(); }
+    constexpr const T &operator[](std::size_t i) const noexcept
+    {
+        _LIBPOWERCXX_UNREACHABLE();
+    }
 
-    T &at(std::size_t i) { _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, 0); }
+    constexpr T &at(std::size_t i) { _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, 0); }
 
-    const T &at(std::size_t i) const { _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, 0); }
+    constexpr const T &at(std::size_t i) const { _LIBPOWERCXX_THROW_OUT_OF_RANGE(i, 0); }
 
-    void fill(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>) { }
+    constexpr void fill(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>) { }
 
-    void swap(Array &that) noexcept(std::is_nothrow_swappable_v<T>) { }
+    constexpr void swap(Array &that) noexcept(std::is_nothrow_swappable_v<T>) { }
 
-    T &front() noexcept { _LIBPOWERCXX_UNREACHABLE(); }
+    constexpr T &front() noexcept { _LIBPOWERCXX_UNREACHABLE(); }
 
-    const T &front() const noexcept { _LIBPOWERCXX_UNREACHABLE(); }
+    constexpr const T &front() const noexcept { _LIBPOWERCXX_UNREACHABLE(); }
 
-    T &back() noexcept { _LIBPOWERCXX_UNREACHABLE(); }
+    constexpr T &back() noexcept { _LIBPOWERCXX_UNREACHABLE(); }
 
-    const T &back() const noexcept { _LIBPOWERCXX_UNREACHABLE(); }
+    constexpr const T &back() const noexcept { _LIBPOWERCXX_UNREACHABLE(); }
 
     static constexpr std::size_t empty() noexcept { return true; }
 
@@ -169,36 +274,94 @@ class Array<T, 0>
 
     static constexpr std::size_t max_size() noexcept { return 0; }
 
-    T *data() noexcept { return nullptr; }
+    constexpr T *data() noexcept { return nullptr; }
+
+    constexpr const T *data() const noexcept { return nullptr; }
+
+    constexpr const T *cdata() const noexcept { return nullptr; }
+
+    constexpr T *begin() noexcept { return nullptr; }
+
+    constexpr T *end() noexcept { return nullptr; }
+
+    constexpr const T *begin() const noexcept { return nullptr; }
+
+    constexpr const T *end() const noexcept { return nullptr; }
 
-    const T *data() const noexcept { return nullptr; }
+    constexpr const T *cbegin() const noexcept { return nullptr; }
 
-    const T *cdata() const noexcept { return nullptr; }
+    constexpr const T *cend() const noexcept { return nullptr; }
 
-    T *begin() noexcept { return nullptr; }
+    constexpr reverse_iterator rbegin() noexcept { return {}; }
 
-    T *end() noexcept { return nullptr; }
+    constexpr reverse_iterator rend() noexcept { return {}; }
 
-    const T *begin() const noexcept { return nullptr; }
+    constexpr const_reverse_iterator rbegin() const noexcept { return {}; }
 
-    const T *end() const noexcept { return nullptr; }
+    constexpr const_reverse_iterator rend() const noexcept { return {}; }
 
-    const T *cbegin() const noexcept { return nullptr; }
+    constexpr const_reverse_iterator crbegin() const noexcept { return {}; }
 
-    const T *cend() const noexcept { return nullptr; }
+    constexpr const_reverse_iterator crend() const noexcept { return {}; }
 
-    reverse_iterator rbegin() noexcept { return nullptr; }
+    constexpr T *find(const T &value) noexcept { return nullptr; }
 
-    reverse_iterator rend() noexcept { return nullptr; }
+    constexpr const T *find(const T &value) const noexcept { return nullptr; }
 
-    const_reverse_iterator rbegin() const noexcept { return nullptr; }
+    constexpr std::size_t count(const T &value) const noexcept { return 0; }
 
-    const_reverse_iterator rend() const noexcept { return nullptr; }
+    constexpr bool contains(const T &value) const noexcept { return false; }
 
-    const_reverse_iterator crbegin() const noexcept { return nullptr; }
+    template<typename Compare = std::less<>>
+    constexpr void sort(Compare comp = Compare()) { }
 
-    const_reverse_iterator crend() const noexcept { return nullptr; }
+    template<typename U, typename Compare = std::less<>>
+    constexpr T *lower_bound(const U &value, Compare comp = Compare())
+    {
+        return nullptr;
+    }
+
+    template<typename U, typename Compare = std::less<>>
+    constexpr const T *lower_bound(const U &value, Compare comp = Compare()) const
+    {
+        return nullptr;
+    }
+
+    template<typename Fn>
+    constexpr void generate(Fn fn) { }
+
+    constexpr bool equal(const Array &that) const noexcept { return true; }
+
+    constexpr std::pair<const T *, const T *> mismatch(const Array &that) const noexcept
+    {
+        return {nullptr, nullptr};
+    }
+
+    constexpr std::strong_ordering compare(const Array &that) const noexcept
+    {
+        return std::strong_ordering::equal;
+    }
+
+    constexpr bool operator==(const Array &that) const noexcept { return true; }
+
+    constexpr std::strong_ordering operator<=>(const Array &that) const noexcept
+    {
+        return std::strong_ordering::equal;
+    }
 };
 
 template<typename Tp, typename... Ts>
 Array(Tp, Ts...) -> Array<Tp, 1 + sizeof...(Ts)>;
+
+/// Array<R, N> holding fn(0), ..., fn(N - 1), where R is what fn returns. In a
+/// constexpr variable this builds a lookup table at compile time into read-only data:
+///     constexpr auto sq = make_array_from<256>([](std::size_t i) { return i * i; });
+template<std::size_t N, typename Fn>
+constexpr auto make_array_from(Fn fn)
+{
+    using R = std::remove_cvref_t<std::invoke_result_t<Fn &, std::size_t>>;
+    Array<R, N> result {};
+    for (std::size_t i = 0; i < N; i++)
+        result[i] = fn(i);
+    return result;
+}
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <cmath>         // std::sqrt
+#include <cstddef>       // size_t
+#include <tuple>         // std::tuple, std::apply
+#include <type_traits>
+
+#include "Array.hpp"
+#include "SimdPack.hpp"
+
+// Elementwise arithmetic on Array<T, N> of arithmetic T through expression templates.
+// An expression such as a * b + c * 2.f builds a small tree of nodes and computes
+// nothing. Converting it to an Array, assigning it to one, or a compound assignment
+// runs one loop over the elements that evaluates the whole tree a pack at a time. The
+// same node code serves SimdPack<T, Bytes> in the body and plain T in the tail, since
+// every operator below is written once for both.
+//
+// Nodes refer to the Arrays they read, so an expression kept with auto must not
+// outlive them.
+
+struct ExprPlus
+{
+    template<typename V>
+    V operator()(const V &a, const V &b) const noexcept
+    {
+        return a + b;
+    }
+};
+
+struct ExprMinus
+{
+    template<typename V>
+    V operator()(const V &a, const V &b) const noexcept
+    {
+        return a - b;
+    }
+};
+
+struct ExprMultiplies
+{
+    template<typename V>
+    V operator()(const V &a, const V &b) const noexcept
+    {
+        return a * b;
+    }
+};
+
+struct ExprDivides
+{
+    template<typename V>
+    V operator()(const V &a, const V &b) const noexcept
+    {
+        return a / b;
+    }
+};
+
+struct ExprNegate
+{
+    template<typename V>
+    V operator()(const V &a) const noexcept
+    {
+        return -a;
+    }
+};
+
+// same choice as std::min and std::max when the operands are unordered
+struct ExprMin
+{
+    template<typename V>
+    V operator()(const V &a, const V &b) const noexcept
+    {
+        return b < a ? b : a;
+    }
+};
+
+struct ExprMax
+{
+    template<typename V>
+    V operator()(const V &a, const V &b) const noexcept
+    {
+        return a < b ? b : a;
+    }
+};
+
+// GNU mode contracts this into one fused multiply-add where the target has FMA
+struct ExprFma
+{
+    template<typename V>
+    V operator()(const V &a, const V &b, const V &c) const noexcept
+    {
+        return a * b + c;
+    }
+};
+
+/// Leaf reading an Array in place.
+template<typename T>
+struct ArrayLeaf
+{
+    const T *data;
+
+    template<typename V>
+    V load(std::size_t i) const noexcept
+    {
+        return simdLoad<V>(data + i);
+    }
+};
+
+/// Leaf repeating a scalar operand in every lane.
+template<typename T>
+struct ArrayScalar
+{
+    T value;
+
+    template<typename V>
+    V load(std::size_t) const noexcept
+    {
+        return simdBroadcast<V>(value);
+    }
+};
+
+template<typename T, std::size_t N, typename Op, typename... Args>
+struct ArrayExpr;
+
+/// Scalars an Array of T takes as operands: those T {e} accepts without narrowing, and
+/// integers when T is floating-point, as in a * 2 on floats. So Array<int, N> * 2.5
+/// does not compile instead of scaling by 2.
+template<typename E, typename T>
+concept ArrayScalarOperand =
+        std::is_arithmetic_v<E> &&
+        (requires(E e) { T {e}; } ||
+         (std::is_integral_v<E> && std::is_floating_point_v<T>));
+
+/// What an operand of the operators below is: an Array, an expression over Arrays,
+/// or neither (then it may still be a scalar).
+template<typename E>
+struct ArrayShape
+{
+    static constexpr bool isArray = false;
+
+    template<typename T, std::size_t N>
+    static constexpr bool fits = ArrayScalarOperand<E, T>;
+};
+
+template<typename T, std::size_t N>
+    requires(N != 0 && std::is_arithmetic_v<T>)
+struct ArrayShape<Array<T, N>>
+{
+    static constexpr bool isArray = true;
+    using value_type              = T;
+    static constexpr std::size_t size = N;
+
+    template<typename U, std::size_t M>
+    static constexpr bool fits = std::is_same_v<T, U> && N == M;
+};
+
+template<typename T, std::size_t N, typename Op, typename... Args>
+struct ArrayShape<ArrayExpr<T, N, Op, Args...>> : ArrayShape<Array<T, N>>
+{ };
+
+template<typename... Es>
+struct FirstArrayShape
+{
+    using value_type = void;
+    static constexpr std::size_t size = 0;
+};
+
+template<typename E, typename... Es>
+struct FirstArrayShape<E, Es...>
+    : std::conditional_t<ArrayShape<E>::isArray, ArrayShape<E>, FirstArrayShape<Es...>>
+{ };
+
+/// Operands of one elementwise operation: at least one Array or expression, all of
+/// them of one value type and size, and arithmetic scalars for the rest.
+template<typename... Es>
+concept ArrayOperands =
+        (ArrayShape<Es>::isArray || ...) &&
+        (ArrayShape<Es>::template fits<typename FirstArrayShape<Es...>::value_type,
+                                       FirstArrayShape<Es...>::size> &&
+         ...);
+
+template<typename T, typename E>
+auto toArrayNode(const E &operand) noexcept
+{
+    if constexpr (!ArrayShape<E>::isArray)
+        return ArrayScalar<T> {static_cast<T>(operand)};
+    else if constexpr (std::is_same_v<E, Array<T, ArrayShape<E>::size>>)
+        return ArrayLeaf<T> {operand.data()};
+    else
+        return operand;
+}
+
+template<typename Op, typename... Es>
+auto makeArrayExpr(const Es &...operands) noexcept
+{
+    using T                     = typename FirstArrayShape<Es...>::value_type;
+    constexpr std::size_t kSize = FirstArrayShape<Es...>::size;
+    return ArrayExpr<T, kSize, Op, decltype(toArrayNode<T>(operands))...> {
+            {toArrayNode<T>(operands)...}};
+}
+
+/// Op applied elementwise to the Args nodes, each an ArrayLeaf, an ArrayScalar or
+/// another ArrayExpr.
+template<typename T, std::size_t N, typename Op, typename... Args>
+struct ArrayExpr
+{
+    using value_type = T;
+
+    std::tuple<Args...> args;
+
+    static constexpr std::size_t size() noexcept { return N; }
+
+    template<typename V>
+    V load(std::size_t i) const noexcept
+    {
+        return std::apply(
+                [i](const Args &...arg) { return Op {}(arg.template load<V>(i)...); },
+                args);
+    }
+
+    T operator[](std::size_t i) const noexcept { return load<T>(i); }
+
+    /// Evaluate into dst, which may be one of the Arrays the expression reads: every
+    /// pack is loaded in full before it is stored.
+    void evalInto(T *dst) const noexcept
+    {
+        simdForEach<T, N>([&](auto tag, std::size_t i) {
+            simdStore(dst + i, load<decltype(tag)>(i));
+        });
+    }
+
+    operator Array<T, N>() const noexcept
+    {
+        Array<T, N> result;
+        evalInto(result.data());
+        return result;
+    }
+};
+
+/// The Array an expression computes; an Array is returned as it is.
+template<typename E>
+    requires ArrayOperands<E>
+auto eval(const E &expr) noexcept
+{
+    using Result = Array<typename ArrayShape<E>::value_type, ArrayShape<E>::size>;
+    return Result(expr);
+}
+
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto operator+(const L &lhs, const R &rhs) noexcept
+{
+    return makeArrayExpr<ExprPlus>(lhs, rhs);
+}
+
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto operator-(const L &lhs, const R &rhs) noexcept
+{
+    return makeArrayExpr<ExprMinus>(lhs, rhs);
+}
+
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto operator*(const L &lhs, const R &rhs) noexcept
+{
+    return makeArrayExpr<ExprMultiplies>(lhs, rhs);
+}
+
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto operator/(const L &lhs, const R &rhs) noexcept
+{
+    return makeArrayExpr<ExprDivides>(lhs, rhs);
+}
+
+template<typename E>
+    requires ArrayOperands<E>
+auto operator-(const E &expr) noexcept
+{
+    return makeArrayExpr<ExprNegate>(expr);
+}
+
+/// Lane-wise min and max; std::min would compare whole Arrays lexicographically.
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto elementwiseMin(const L &lhs, const R &rhs) noexcept
+{
+    return makeArrayExpr<ExprMin>(lhs, rhs);
+}
+
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto elementwiseMax(const L &lhs, const R &rhs) noexcept
+{
+    return makeArrayExpr<ExprMax>(lhs, rhs);
+}
+
+/// a * b + c elementwise, rounded once where the target has FMA.
+template<typename A, typename B, typename C>
+    requires ArrayOperands<A, B, C>
+auto fma(const A &a, const B &b, const C &c) noexcept
+{
+    return makeArrayExpr<ExprFma>(a, b, c);
+}
+
+#define _LIBPOWERCXX_ARRAY_COMPOUND_ASSIGN(__op, __Op)                              \
+    template<typename T, std::size_t N, typename E>                                 \
+        requires ArrayOperands<Array<T, N>, E>                                      \
+    Array<T, N> &operator __op(Array<T, N> &lhs, const E &rhs) noexcept             \
+    {                                                                               \
+        makeArrayExpr<__Op>(lhs, rhs).evalInto(lhs.data());                         \
+        return lhs;                                                                 \
+    }
+
+_LIBPOWERCXX_ARRAY_COMPOUND_ASSIGN(+=, ExprPlus)
+_LIBPOWERCXX_ARRAY_COMPOUND_ASSIGN(-=, ExprMinus)
+_LIBPOWERCXX_ARRAY_COMPOUND_ASSIGN(*=, ExprMultiplies)
+_LIBPOWERCXX_ARRAY_COMPOUND_ASSIGN(/=, ExprDivides)
+
+#undef _LIBPOWERCXX_ARRAY_COMPOUND_ASSIGN
+
+// Reductions fold packs into per-lane accumulators and the lanes together at the
+// end, so a floating-point sum adds in a different order than a plain loop does.
+
+template<typename Op, typename E>
+auto reduceArrayExpr(const E &expr) noexcept
+{
+    using T   = typename ArrayShape<E>::value_type;
+    auto node = toArrayNode<T>(expr);
+    return simdReduce<T, ArrayShape<E>::size>(
+            [&](auto tag, std::size_t i) { return node.template load<decltype(tag)>(i); },
+            Op {});
+}
+
+template<typename E>
+    requires ArrayOperands<E>
+auto sum(const E &expr) noexcept
+{
+    return reduceArrayExpr<ExprPlus>(expr);
+}
+
+template<typename L, typename R>
+    requires ArrayOperands<L, R>
+auto dot(const L &lhs, const R &rhs) noexcept
+{
+    return sum(lhs * rhs);
+}
+
+/// Euclidean norm, sqrt(dot(x, x)).
+template<typename E>
+    requires ArrayOperands<E>
+auto norm(const E &expr) noexcept
+{
+    return std::sqrt(dot(expr, expr));
+}
+
+template<typename E>
+    requires ArrayOperands<E>
+auto minValue(const E &expr) noexcept
+{
+    return reduceArrayExpr<ExprMin>(expr);
+}
+
+template<typename E>
+    requires ArrayOperands<E>
+auto maxValue(const E &expr) noexcept
+{
+    return reduceArrayExpr<ExprMax>(expr);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+/// Keep the compiler from discarding a value that a benchmark only computes.
+template<typename T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(__clang__) || defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &value;
+#endif
+}
+
+/// Run fn once and return the elapsed wall time in milliseconds.
+template<typename F>
+double measureMs(F &&fn)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+inline void report(const char *name, double ms) { printf("%-40s %10.3f ms\n", name, ms); }
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+/// Append-only vector for many concurrent writers. Storage is a fixed table of
+/// geometrically growing segments (kFirstSegment, 2x, 4x, ...), so an element never
+/// moves once written and references stay valid for the container's lifetime.
+///
+/// emplace_back reserves an index with one fetch_add, installs the segment with a CAS
+/// if it is the first to reach it, constructs in place and then publishes the slot.
+/// Nothing ever blocks on another thread: a writer that finds a segment being
+/// installed yields for a bounded time, then races to install its own copy. Readers
+/// see published elements through snapshot(), which covers the longest fully
+/// published prefix.
+template<typename T, typename Alloc = std::allocator<T>>
+struct ConcurrentVector
+{
+    using value_type      = T;
+    using allocator_type  = Alloc;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T &;
+    using const_reference = const T &;
+
+    static constexpr std::size_t kFirstSegment = 32;
+    static constexpr std::size_t kMaxSegments  = 48;
+
+  private:
+    enum SlotState : std::uint8_t { Empty, Ready, Failed };
+
+    struct Slot
+    {
+        std::atomic<std::uint8_t> state {Empty};
+
+        union
+        {
+            T value;
+        };
+
+        Slot() noexcept { }
+
+        ~Slot() { }
+    };
+
+    using AllocSlot = std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+
+    static constexpr int kInstallPatience = 1024;
+
+    std::atomic<Slot *> mSegments[kMaxSegments] {};
+    std::atomic<bool> mInstalling[kMaxSegments] {};
+    // writers and readers hammer different counters, keep them on separate lines
+    alignas(64) std::atomic<std::size_t> mSize {0};                // reserved indices
+    alignas(64) mutable std::atomic<std::size_t> mPublished {0};   // published prefix
+    [[no_unique_address]] Alloc mAlloc;
+
+    static std::size_t segmentOf(std::size_t i) noexcept
+    {
+        return std::bit_width(i / kFirstSegment + 1) - 1;
+    }
+
+    static std::size_t segmentBase(std::size_t k) noexcept
+    {
+        return kFirstSegment * ((std::size_t(1) << k) - 1);
+    }
+
+    static std::size_t segmentLength(std::size_t k) noexcept
+    {
+        return kFirstSegment << k;
+    }
+
+    /// Stands in for a segment that could not be allocated while writers held
+    /// indices in it: all of its indices are tombstones and no element lives there.
+    static Slot *failedSegment() noexcept
+    {
+        static Slot marker;
+        return &marker;
+    }
+
+    /// Whether slot i is in an installed segment and holds a published element.
+    bool ready(std::size_t i) const noexcept
+    {
+        std::size_t k = segmentOf(i);
+        Slot *seg     = mSegments[k].load(std::memory_order_acquire);
+        return seg && seg != failedSegment() &&
+               seg[i - segmentBase(k)].state.load(std::memory_order_acquire) == Ready;
+    }
+
+    Slot &slot(std::size_t i) const noexcept
+    {
+        std::size_t k = segmentOf(i);
+        return mSegments[k].load(std::memory_order_acquire)[i - segmentBase(k)];
+    }
+
+    Slot *segment(std::size_t k)
+    {
+        Slot *seg = mSegments[k].load(std::memory_order_acquire);
+        if (seg) [[likely]]
+            return seg;
+
+        // let whoever started installing segment k finish, but only for a bounded
+        // time: a preempted installer must not stall everyone else
+        if (mInstalling[k].exchange(true, std::memory_order_acq_rel))
+        {
+            for (int spins = 0; spins != kInstallPatience; spins++)
+            {
+                std::this_thread::yield();
+                if ((seg = mSegments[k].load(std::memory_order_acquire)))
+                    return seg;
+            }
+        }
+
+        // first writer to publish segment k wins; losers free their copy
+        Slot *fresh = AllocSlot {mAlloc}.allocate(segmentLength(k));
+        std::uninitialized_default_construct_n(fresh, segmentLength(k));
+        if (mSegments[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel))
+            return fresh;
+
+        std::destroy_n(fresh, segmentLength(k));
+        AllocSlot {mAlloc}.deallocate(fresh, segmentLength(k));
+        return seg;
+    }
+
+  public:
+    ConcurrentVector() noexcept = default;
+
+    explicit ConcurrentVector(const Alloc &alloc) noexcept : mAlloc(alloc) { }
+
+    ConcurrentVector(const ConcurrentVector &)            = delete;
+    ConcurrentVector &operator=(const ConcurrentVector &) = delete;
+
+    ~ConcurrentVector() noexcept
+    {
+        for (std::size_t k = 0; k != kMaxSegments; k++)
+        {
+            Slot *seg = mSegments[k].load(std::memory_order_relaxed);
+            if (!seg || seg == failedSegment())
+                continue;
+
+            for (std::size_t i = 0; i != segmentLength(k); i++)
+                if (seg[i].state.load(std::memory_order_relaxed) == Ready)
+                    std::destroy_at(&seg[i].value);
+            std::destroy_n(seg, segmentLength(k));
+            AllocSlot {mAlloc}.deallocate(seg, segmentLength(k));
+        }
+    }
+
+    /// Construct a new element and return a reference that stays valid until the
+    /// container is destroyed. If the constructor throws, the reserved slot becomes a
+    /// tombstone that snapshots skip. If the slot's segment cannot be allocated, so
+    /// does the slot, or the whole segment while it is still missing; later writers
+    /// skip past a segment given up that way.
+    template<typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        std::size_t i, k;
+        Slot *seg;
+        do
+        {
+            i = mSize.fetch_add(1, std::memory_order_relaxed);
+            k = segmentOf(i);
+            try
+            {
+                seg = segment(k);
+            }
+            catch (...)
+            {
+                Slot *installed = nullptr;
+                if (!mSegments[k].compare_exchange_strong(installed,
+                                                          failedSegment(),
+                                                          std::memory_order_acq_rel) &&
+                    installed != failedSegment())
+                {
+                    installed[i - segmentBase(k)].state.store(Failed,
+                                                              std::memory_order_release);
+                }
+                throw;
+            }
+        } while (seg == failedSegment());
+        Slot &s = seg[i - segmentBase(k)];
+
+        // install the next segment half way through this one, so writers rarely find
+        // it missing and race to allocate it; whoever needs it retries on failure
+        if (i - segmentBase(k) == segmentLength(k) / 2 && k + 1 != kMaxSegments)
+        {
+            try
+            {
+                segment(k + 1);
+            }
+            catch (const std::bad_alloc &)
+            { }
+        }
+
+        try
+        {
+            std::construct_at(&s.value, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            s.state.store(Failed, std::memory_order_release);
+            throw;
+        }
+        s.state.store(Ready, std::memory_order_release);
+        return s.value;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /// Number of indices handed out so far, including elements still being written
+    /// and tombstones.
+    std::size_t size() const noexcept { return mSize.load(std::memory_order_acquire); }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Element i, which the caller must know to be published (e.g. it wrote it, or i
+    /// lies inside a snapshot).
+    T &operator[](std::size_t i) noexcept { return slot(i).value; }
+
+    const T &operator[](std::size_t i) const noexcept { return slot(i).value; }
+
+    struct Snapshot
+    {
+        struct iterator
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const T *;
+            using reference         = const T &;
+
+            iterator() = default;
+
+            const T &operator*() const noexcept { return mOwner->slot(mIndex).value; }
+
+            const T *operator->() const noexcept { return &**this; }
+
+            iterator &operator++() noexcept
+            {
+                ++mIndex;
+                skipTombstones();
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const iterator &that) const noexcept
+            {
+                return mIndex == that.mIndex;
+            }
+
+          private:
+            friend Snapshot;
+
+            const ConcurrentVector *mOwner = nullptr;
+            std::size_t mIndex             = 0;
+            std::size_t mEnd               = 0;
+
+            iterator(const ConcurrentVector *owner,
+                     std::size_t i,
+                     std::size_t end) noexcept
+                : mOwner(owner), mIndex(i), mEnd(end)
+            {
+                skipTombstones();
+            }
+
+            void skipTombstones() noexcept
+            {
+                while (mIndex != mEnd && !mOwner->ready(mIndex))
+                    ++mIndex;
+            }
+        };
+
+        iterator begin() const noexcept { return iterator {mOwner, 0, mSize}; }
+
+        iterator end() const noexcept { return iterator {mOwner, mSize, mSize}; }
+
+        /// Slots covered, tombstones included.
+        std::size_t size() const noexcept { return mSize; }
+
+      private:
+        friend ConcurrentVector;
+
+        const ConcurrentVector *mOwner;
+        std::size_t mSize;
+
+        Snapshot(const ConcurrentVector *owner, std::size_t size) noexcept
+            : mOwner(owner), mSize(size)
+        { }
+    };
+
+    /// View of the longest prefix in which every slot is published. Elements appended
+    /// later are not visible through it; take a new snapshot to see them.
+    Snapshot snapshot() const noexcept
+    {
+        std::size_t n     = mPublished.load(std::memory_order_acquire);
+        std::size_t limit = size();
+        for (; n != limit; n++)
+        {
+            // an index can be reserved before its writer has installed the segment
+            std::size_t k = segmentOf(n);
+            Slot *seg     = mSegments[k].load(std::memory_order_acquire);
+            if (!seg)
+                break;
+            if (seg == failedSegment())   // a segment of tombstones
+                n = std::min(segmentBase(k + 1), limit) - 1;
+            else if (seg[n - segmentBase(k)].state.load(std::memory_order_acquire) ==
+                     Empty)
+                break;
+        }
+
+        // remember the progress for the next caller; another reader may be further on
+        std::size_t seen = mPublished.load(std::memory_order_relaxed);
+        while (seen < n &&
+               !mPublished.compare_exchange_weak(seen, n, std::memory_order_release))
+        { }
+        return Snapshot {this, n};
+    }
+
+    Alloc get_allocator() const noexcept { return mAlloc; }
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include <sys/mman.h>
+
+inline constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+/// Process-wide counters shared by every HugePageAllocator instantiation.
+struct HugePageStats
+{
+    std::atomic<std::uint64_t> advisedBytes {0};    // live, 2MB-aligned, MADV_HUGEPAGE
+    std::atomic<std::uint64_t> fallbackBytes {0};   // live, from std::allocator
+
+    /// Bytes of anonymous memory the kernel actually backs with huge pages right now
+    /// (AnonHugePages in /proc/self/smaps_rollup); 0 where that is unavailable.
+    static std::uint64_t residentHugeBytes()
+    {
+        std::FILE *f = std::fopen("/proc/self/smaps_rollup", "r");
+        if (!f)
+            return 0;
+
+        char line[256];
+        unsigned long long kb = 0;
+        while (std::fgets(line, sizeof(line), f))
+        {
+            if (std::sscanf(line, "AnonHugePages: %llu kB", &kb) == 1)
+                break;
+        }
+        std::fclose(f);
+        return kb * 1024;
+    }
+};
+
+inline HugePageStats &hugePageStats() noexcept
+{
+    static HugePageStats stats;
+    return stats;
+}
+
+/// Allocator for large random-access tables. Blocks of at least Threshold bytes are
+/// 2MB-aligned anonymous mappings advised with MADV_HUGEPAGE, so transparent huge
+/// pages can back them and cut TLB misses; smaller blocks come from std::allocator.
+template<typename T, std::size_t Threshold = kHugePageSize>
+struct HugePageAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U, Threshold> &) noexcept
+    { }
+
+    T *allocate(std::size_t n)
+    {
+        if (!isHuge(n))
+        {
+            hugePageStats().fallbackBytes.fetch_add(n * sizeof(T),
+                                                    std::memory_order_relaxed);
+            return std::allocator<T>().allocate(n);
+        }
+
+        // over-map by one huge page, then trim both ends down to an aligned region
+        std::size_t bytes = hugeBytes(n);
+
+        void *raw = ::mmap(nullptr,
+                           bytes + kHugePageSize,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS,
+                           -1,
+                           0);
+        if (raw == MAP_FAILED) [[unlikely]]
+            throw std::bad_alloc();
+
+        auto addr    = reinterpret_cast<std::uintptr_t>(raw);
+        auto aligned = (addr + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        if (aligned != addr)
+            ::munmap(raw, aligned - addr);
+        if (std::size_t tail = kHugePageSize - (aligned - addr))
+            ::munmap(reinterpret_cast<void *>(aligned + bytes), tail);
+
+#ifdef MADV_HUGEPAGE
+        ::madvise(reinterpret_cast<void *>(aligned), bytes, MADV_HUGEPAGE);
+#endif
+        hugePageStats().advisedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        return reinterpret_cast<T *>(aligned);
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        if (!isHuge(n))
+        {
+            hugePageStats().fallbackBytes.fetch_sub(n * sizeof(T),
+                                                    std::memory_order_relaxed);
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+
+        ::munmap(p, hugeBytes(n));
+        hugePageStats().advisedBytes.fetch_sub(hugeBytes(n), std::memory_order_relaxed);
+    }
+
+    bool operator==(const HugePageAllocator &) const noexcept { return true; }
+
+  private:
+    static bool isHuge(std::size_t n) noexcept { return n * sizeof(T) >= Threshold; }
+
+    static std::size_t hugeBytes(std::size_t n) noexcept
+    {
+        return (n * sizeof(T) + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    }
+};
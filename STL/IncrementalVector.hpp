@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Relocate.hpp"
+#include "VectorPolicy.hpp"
+
+/// Vector variant with bounded worst-case append latency. When it runs out of room it
+/// allocates the doubled buffer as usual but does not move everything at once: each
+/// later mutating call relocates at most kMigrateStep old elements. Until migration
+/// completes the elements are split over two buffers and indexing picks the right one:
+///
+///   [0, mMigrated)          new buffer (already moved)
+///   [mMigrated, mOldSize)   old buffer (waiting to move)
+///   [mOldSize, mSize)       new buffer (appended since the growth)
+///
+/// With doubling growth, the appends that fit into the new buffer always outnumber the
+/// elements left to move, so migration is finished before the next growth is due.
+template<typename T, typename Alloc = std::allocator<T>>
+struct IncrementalVector
+{
+    using value_type      = T;
+    using allocator_type  = Alloc;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T &;
+    using const_reference = const T &;
+
+    static constexpr std::size_t kMigrateStep = 2;
+
+  private:
+    T *mData          = nullptr;
+    std::size_t mSize = 0;
+    std::size_t mCap  = 0;
+
+    T *mOld               = nullptr;
+    std::size_t mOldCap   = 0;
+    std::size_t mOldSize  = 0;
+    std::size_t mMigrated = 0;
+
+    [[no_unique_address]] Alloc mAlloc;
+
+    bool inOld(std::size_t i) const noexcept { return i >= mMigrated && i < mOldSize; }
+
+    T *slot(std::size_t i) const noexcept { return inOld(i) ? mOld + i : mData + i; }
+
+    /// Relocate up to n pending elements; free the old buffer once it is empty.
+    void migrate(std::size_t n) noexcept
+    {
+        if (!mOld)
+            return;
+
+        if (mMigrated < mOldSize)
+        {
+            std::size_t last = std::min(mOldSize, mMigrated + n);
+            uninitRelocate(mOld + mMigrated, mOld + last, mData + mMigrated);
+            mMigrated = last;
+        }
+
+        if (mMigrated >= mOldSize)
+        {
+            mAlloc.deallocate(mOld, mOldCap);
+            mOld    = nullptr;
+            mOldCap = mOldSize = mMigrated = 0;
+        }
+    }
+
+    void grow(std::size_t n)
+    {
+        finish_migration();
+        T *fresh = mAlloc.allocate(n);
+        if (mCap != 0)
+        {
+            mOld      = mData;
+            mOldCap   = mCap;
+            mOldSize  = mSize;
+            mMigrated = 0;
+        }
+        mData = fresh;
+        mCap  = n;
+    }
+
+  public:
+    static_assert(isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>,
+                  "migration steps run inside noexcept operations");
+
+    IncrementalVector() noexcept = default;
+
+    explicit IncrementalVector(const Alloc &alloc) noexcept : mAlloc(alloc) { }
+
+    IncrementalVector(const IncrementalVector &)            = delete;
+    IncrementalVector &operator=(const IncrementalVector &) = delete;
+
+    IncrementalVector(IncrementalVector &&that) noexcept
+        : mData(std::exchange(that.mData, nullptr)),
+          mSize(std::exchange(that.mSize, 0)),
+          mCap(std::exchange(that.mCap, 0)),
+          mOld(std::exchange(that.mOld, nullptr)),
+          mOldCap(std::exchange(that.mOldCap, 0)),
+          mOldSize(std::exchange(that.mOldSize, 0)),
+          mMigrated(std::exchange(that.mMigrated, 0)),
+          mAlloc(std::move(that.mAlloc))
+    { }
+
+    ~IncrementalVector() noexcept
+    {
+        clear();
+        if (mOld)
+            mAlloc.deallocate(mOld, mOldCap);
+        if (mCap != 0)
+            mAlloc.deallocate(mData, mCap);
+    }
+
+    std::size_t size() const noexcept { return mSize; }
+
+    std::size_t capacity() const noexcept { return mCap; }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    /// True while some elements still sit in the previous buffer.
+    bool migrating() const noexcept { return mOld != nullptr; }
+
+    void finish_migration() noexcept { migrate(mOldSize); }
+
+    /// Explicit reserve is a caller-chosen pause, so it completes in one go.
+    void reserve(std::size_t n)
+    {
+        if (n <= mCap)
+            return;
+
+        grow(n);
+        finish_migration();
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (mSize == mCap) [[unlikely]]
+            grow(std::max<std::size_t>(mSize + 1, DoublingGrowth {}(mCap, mSize + 1)));
+
+        T *p = std::construct_at(mData + mSize, std::forward<Args>(args)...);
+        ++mSize;
+        migrate(kMigrateStep);
+        return *p;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept
+    {
+        --mSize;
+        std::destroy_at(slot(mSize));
+        if (mSize < mOldSize)
+            mOldSize = mSize;   // nothing left to move for that index
+        migrate(kMigrateStep);
+    }
+
+    void clear() noexcept
+    {
+        for (std::size_t i = 0; i != mSize; i++)
+            std::destroy_at(slot(i));
+        mSize    = 0;
+        mOldSize = 0;
+        migrate(0);   // releases the old buffer
+    }
+
+    T &operator[](std::size_t i) noexcept { return *slot(i); }
+
+    const T &operator[](std::size_t i) const noexcept { return *slot(i); }
+
+    T &at(std::size_t i)
+    {
+        if (i >= mSize) [[unlikely]]
+            throw std::out_of_range("IncrementalVector at function");
+        return *slot(i);
+    }
+
+    const T &at(std::size_t i) const
+    {
+        if (i >= mSize) [[unlikely]]
+            throw std::out_of_range("IncrementalVector at function");
+        return *slot(i);
+    }
+
+    T &front() noexcept { return *slot(0); }
+
+    const T &front() const noexcept { return *slot(0); }
+
+    T &back() noexcept { return *slot(mSize - 1); }
+
+    const T &back() const noexcept { return *slot(mSize - 1); }
+
+    /// Contiguous view; completes any pending migration first.
+    T *data() noexcept
+    {
+        finish_migration();
+        return mData;
+    }
+
+    template<bool Const>
+    struct Iterator
+    {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+        using owner_pointer     = std::conditional_t<Const,
+                                                     const IncrementalVector *,
+                                                     IncrementalVector *>;
+
+        owner_pointer mOwner = nullptr;
+        std::size_t mIndex   = 0;
+
+        reference operator*() const noexcept { return (*mOwner)[mIndex]; }
+
+        pointer operator->() const noexcept { return &(*mOwner)[mIndex]; }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return (*mOwner)[mIndex + n];
+        }
+
+        Iterator &operator++() noexcept
+        {
+            ++mIndex;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++mIndex;
+            return tmp;
+        }
+
+        Iterator &operator--() noexcept
+        {
+            --mIndex;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --mIndex;
+            return tmp;
+        }
+
+        Iterator &operator+=(difference_type n) noexcept
+        {
+            mIndex += n;
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type n) noexcept
+        {
+            mIndex -= n;
+            return *this;
+        }
+
+        Iterator operator+(difference_type n) const noexcept
+        {
+            return {mOwner, mIndex + n};
+        }
+
+        Iterator operator-(difference_type n) const noexcept
+        {
+            return {mOwner, mIndex - n};
+        }
+
+        difference_type operator-(const Iterator &that) const noexcept
+        {
+            return static_cast<difference_type>(mIndex - that.mIndex);
+        }
+
+        bool operator==(const Iterator &that) const noexcept
+        {
+            return mIndex == that.mIndex;
+        }
+
+        auto operator<=>(const Iterator &that) const noexcept
+        {
+            return mIndex <=> that.mIndex;
+        }
+    };
+
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() noexcept { return {this, 0}; }
+
+    iterator end() noexcept { return {this, mSize}; }
+
+    const_iterator begin() const noexcept { return {this, 0}; }
+
+    const_iterator end() const noexcept { return {this, mSize}; }
+
+    const_iterator cbegin() const noexcept { return {this, 0}; }
+
+    const_iterator cend() const noexcept { return {this, mSize}; }
+
+    Alloc get_allocator() const noexcept { return mAlloc; }
+};
@@ -0,0 +1,436 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Relocate.hpp"
+#include "Vector.hpp"
+
+/// Node of an IndexList: links are 32-bit indices into the list's arena.
+template<typename T>
+struct IndexListNode
+{
+    std::uint32_t next;
+    std::uint32_t prev;
+
+    union
+    {
+        T value;
+    };
+
+    IndexListNode() noexcept { }
+
+    ~IndexListNode() { }
+};
+
+// the arena grows by relocating nodes wholesale, which is fine exactly when it is for T
+template<typename T>
+struct IsTriviallyRelocatable<IndexListNode<T>> : IsTriviallyRelocatable<T>
+{ };
+
+/// Doubly linked list whose nodes live in one Vector and link to each other by 32-bit
+/// index, so a List<std::uint32_t> node of 16 bytes of links (24 with the value, plus
+/// malloc's header) becomes 12 bytes in a contiguous array. Erased nodes go on a free
+/// list and are reused by the next insert; the arena itself never shrinks, except
+/// through shrink_to_fit() on an empty list.
+///
+/// Iterators hold the list and an index, so they stay valid across arena growth, like
+/// List's, until their element is erased. Element pointers and references do not: an
+/// insert that grows the arena moves every element. reserve() avoids that. T must be
+/// trivially relocatable (see Relocate.hpp), and a list holds at most 2^32 - 2 elements.
+template<typename T, typename Alloc = std::allocator<T>>
+struct IndexList
+{
+    static_assert(isTriviallyRelocatable<T>,
+                  "IndexList relocates its arena on growth: T must be trivially "
+                  "relocatable (specialize IsTriviallyRelocatable to opt in)");
+
+    using value_type      = T;
+    using allocator_type  = Alloc;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = T *;
+    using const_pointer   = const T *;
+    using reference       = T &;
+    using const_reference = const T &;
+
+  private:
+    using Node      = IndexListNode<T>;
+    using AllocNode = std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+    static constexpr std::uint32_t kDummy  = 0;   // index of the sentinel node
+    static constexpr std::uint32_t kNil    = static_cast<std::uint32_t>(-1);
+    static constexpr std::size_t kMaxNodes = kNil;
+
+    Vector<Node, AllocNode> mNodes;   // [0] is the sentinel once anything was inserted
+    std::size_t mSize   = 0;
+    std::uint32_t mFree = kNil;       // free nodes, chained through next
+
+    Node &node(std::uint32_t i) noexcept { return mNodes[i]; }
+
+    const Node &node(std::uint32_t i) const noexcept { return mNodes[i]; }
+
+    /// A node index to fill in, reusing a free one first.
+    std::uint32_t newNode()
+    {
+        if (mFree != kNil)
+        {
+            std::uint32_t i = mFree;
+            mFree           = node(i).next;
+            return i;
+        }
+        if (mNodes.empty()) [[unlikely]]
+        {
+            Node &dummy = mNodes.emplace_back();
+            dummy.next = dummy.prev = kDummy;
+        }
+        if (mNodes.size() == kMaxNodes) [[unlikely]]
+            throw std::length_error("IndexList too long at newNode");
+        mNodes.emplace_back();
+        return static_cast<std::uint32_t>(mNodes.size() - 1);
+    }
+
+    void deleteNode(std::uint32_t i) noexcept
+    {
+        node(i).next = mFree;
+        mFree        = i;
+    }
+
+    void link(std::uint32_t pos, std::uint32_t i) noexcept
+    {
+        std::uint32_t prev = node(pos).prev;
+        node(i).prev       = prev;
+        node(i).next       = pos;
+        node(prev).next    = i;
+        node(pos).prev     = i;
+    }
+
+    void unlink(std::uint32_t i) noexcept
+    {
+        node(node(i).prev).next = node(i).next;
+        node(node(i).next).prev = node(i).prev;
+    }
+
+    std::uint32_t first() const noexcept { return mSize ? node(kDummy).next : kDummy; }
+
+    std::uint32_t last() const noexcept { return mSize ? node(kDummy).prev : kDummy; }
+
+    template<typename... Args>
+    std::uint32_t emplaceNode(std::uint32_t pos, Args &&...args)
+    {
+        std::uint32_t i = newNode();
+        try
+        {
+            std::construct_at(&node(i).value, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deleteNode(i);
+            throw;
+        }
+        link(pos, i);
+        ++mSize;
+        return i;
+    }
+
+  public:
+    IndexList() noexcept = default;
+
+    explicit IndexList(const Alloc &alloc) noexcept : mNodes(AllocNode(alloc)) { }
+
+    IndexList(std::initializer_list<T> ilist, const Alloc &alloc = Alloc())
+        : IndexList(ilist.begin(), ilist.end(), alloc)
+    { }
+
+    template<std::input_iterator InputIt>
+    IndexList(InputIt first, InputIt last, const Alloc &alloc = Alloc())
+        : mNodes(AllocNode(alloc))
+    {
+        if constexpr (std::forward_iterator<InputIt>)
+            reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    IndexList(const IndexList &that) : mNodes(that.mNodes.get_allocator())
+    {
+        reserve(that.size());
+        for (const T &value: that)
+            emplace_back(value);
+    }
+
+    IndexList(IndexList &&that) noexcept
+        : mNodes(std::move(that.mNodes)),
+          mSize(std::exchange(that.mSize, 0)),
+          mFree(std::exchange(that.mFree, kNil))
+    { }
+
+    IndexList &operator=(const IndexList &that)
+    {
+        if (&that != this) [[likely]]
+        {
+            clear();
+            reserve(that.size());
+            for (const T &value: that)
+                emplace_back(value);
+        }
+        return *this;
+    }
+
+    IndexList &operator=(IndexList &&that) noexcept
+    {
+        if (&that != this) [[likely]]
+        {
+            clear();
+            mNodes = std::move(that.mNodes);
+            mSize  = std::exchange(that.mSize, 0);
+            mFree  = std::exchange(that.mFree, kNil);
+        }
+        return *this;
+    }
+
+    ~IndexList() noexcept { clear(); }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    std::size_t size() const noexcept { return mSize; }
+
+    static constexpr std::size_t max_size() noexcept { return kMaxNodes - 1; }
+
+    /// Nodes the arena holds without growing, free and live ones alike.
+    std::size_t capacity() const noexcept
+    {
+        return mNodes.capacity() ? mNodes.capacity() - 1 : 0;
+    }
+
+    /// Make room for n elements in all, so inserts up to there never move elements.
+    void reserve(std::size_t n)
+    {
+        if (n >= kMaxNodes) [[unlikely]]
+            throw std::length_error("IndexList too long at reserve");
+        mNodes.reserve(n + 1);
+    }
+
+    /// Release the arena of an empty list; a non-empty one keeps its nodes in place.
+    void shrink_to_fit() noexcept
+    {
+        if (mSize == 0)
+        {
+            mNodes.clear();
+            mNodes.shrink_to_fit();
+            mFree = kNil;
+        }
+    }
+
+    T &front() noexcept { return node(first()).value; }
+
+    const T &front() const noexcept { return node(first()).value; }
+
+    T &back() noexcept { return node(last()).value; }
+
+    const T &back() const noexcept { return node(last()).value; }
+
+    template<bool Const>
+    struct Iterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+
+      private:
+        using List = std::conditional_t<Const, const IndexList, IndexList>;
+
+        List *mList;
+        std::uint32_t mCurr;
+
+        friend IndexList;
+
+        Iterator(List *list, std::uint32_t curr) noexcept : mList(list), mCurr(curr) { }
+
+      public:
+        Iterator() = default;
+
+        // iterator -> const_iterator
+        template<bool C = Const>
+            requires C
+        Iterator(const Iterator<false> &that) noexcept
+            : mList(that.mList), mCurr(that.mCurr)
+        { }
+
+        template<bool C = Const>
+            requires C
+        explicit operator Iterator<false>() const noexcept
+        {
+            return Iterator<false> {const_cast<IndexList *>(mList), mCurr};
+        }
+
+        // ++iterator
+        Iterator &operator++() noexcept
+        {
+            mCurr = mList->node(mCurr).next;
+            return *this;
+        }
+
+        // iterator++
+        Iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // --iterator
+        Iterator &operator--() noexcept
+        {
+            mCurr = mList->node(mCurr).prev;
+            return *this;
+        }
+
+        // iterator--
+        Iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        reference operator*() const noexcept { return mList->node(mCurr).value; }
+
+        pointer operator->() const noexcept { return &mList->node(mCurr).value; }
+
+        bool operator==(const Iterator &that) const noexcept
+        {
+            return mCurr == that.mCurr;
+        }
+
+        bool operator!=(const Iterator &that) const noexcept { return !(*this == that); }
+
+        friend Iterator<!Const>;
+    };
+
+    using iterator               = Iterator<false>;
+    using const_iterator         = Iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    iterator begin() noexcept { return iterator {this, first()}; }
+
+    iterator end() noexcept { return iterator {this, kDummy}; }
+
+    const_iterator cbegin() const noexcept { return const_iterator {this, first()}; }
+
+    const_iterator cend() const noexcept { return const_iterator {this, kDummy}; }
+
+    const_iterator begin() const noexcept { return cbegin(); }
+
+    const_iterator end() const noexcept { return cend(); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return std::make_reverse_iterator(cend());
+    }
+
+    const_reverse_iterator crend() const noexcept
+    {
+        return std::make_reverse_iterator(cbegin());
+    }
+
+    const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+
+    const_reverse_iterator rend() const noexcept { return crend(); }
+
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args)
+    {
+        // growing the arena moves every element, and args may refer to one of them:
+        // build the value before the move and move it into the new node
+        if (mFree == kNil && mNodes.size() == mNodes.capacity()) [[unlikely]]
+        {
+            T value(std::forward<Args>(args)...);
+            return iterator {this, emplaceNode(pos.mCurr, std::move(value))};
+        }
+        return iterator {this, emplaceNode(pos.mCurr, std::forward<Args>(args)...)};
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        return *emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    T &emplace_front(Args &&...args)
+    {
+        return *emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+
+    iterator insert(const_iterator pos, T &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void push_front(const T &value) { emplace_front(value); }
+
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    iterator erase(const_iterator pos) noexcept
+    {
+        std::uint32_t i    = pos.mCurr;
+        std::uint32_t next = node(i).next;
+        unlink(i);
+        std::destroy_at(&node(i).value);
+        deleteNode(i);
+        --mSize;
+        return iterator {this, next};
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        while (first != last)
+            first = erase(first);
+        return iterator(first);
+    }
+
+    void pop_front() noexcept { erase(cbegin()); }
+
+    void pop_back() noexcept { erase(const_iterator {this, last()}); }
+
+    /// Destroy every element; the arena keeps its capacity for the next inserts.
+    void clear() noexcept
+    {
+        if (mNodes.empty())
+            return;
+        for (std::uint32_t i = first(); i != kDummy; i = node(i).next)
+            std::destroy_at(&node(i).value);
+        mNodes.resize_for_overwrite(1);
+        node(kDummy).next = node(kDummy).prev = kDummy;
+        mSize                                 = 0;
+        mFree                                 = kNil;
+    }
+
+    Alloc get_allocator() const { return Alloc(mNodes.get_allocator()); }
+
+    bool operator==(const IndexList &that) const noexcept
+    {
+        return std::equal(begin(), end(), that.begin(), that.end());
+    }
+};
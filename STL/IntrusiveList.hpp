@@ -0,0 +1,430 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "List.hpp"
+
+#ifdef NDEBUG
+    #define _LIBPOWERCXX_INTRUSIVE_CHECK(__cond, __msg) ((void) 0)
+#else
+    #define _LIBPOWERCXX_INTRUSIVE_CHECK(__cond, __msg)                \
+        do                                                             \
+        {                                                              \
+            if (!(__cond)) [[unlikely]]                                \
+            {                                                          \
+                std::fprintf(stderr, "IntrusiveList: %s\n", __msg);    \
+                std::abort();                                          \
+            }                                                          \
+        } while (0)
+#endif   // NDEBUG
+
+enum class HookMode
+{
+    Normal,       // the owner must erase the object before destroying it
+    AutoUnlink,   // destroying a linked object unlinks it; size() becomes O(n)
+};
+
+/// Link embedded in an object so it can sit in an IntrusiveList without a separate
+/// node. It has List's node layout (it is a ListBaseNode); an unlinked hook holds null
+/// links. Copying an object never copies its list membership.
+template<HookMode Mode = HookMode::Normal>
+struct ListHook : ListBaseNode<ListHook<Mode>>
+{
+    static constexpr HookMode mode = Mode;
+
+    ListHook() noexcept { this->next = this->prev = nullptr; }
+
+    ListHook(const ListHook &) noexcept : ListHook() { }
+
+    ListHook &operator=(const ListHook &) noexcept { return *this; }
+
+    ~ListHook() noexcept
+    {
+        if constexpr (Mode == HookMode::AutoUnlink)
+            unlink();
+        else
+            _LIBPOWERCXX_INTRUSIVE_CHECK(!is_linked(), "destroying a linked object");
+    }
+
+    bool is_linked() const noexcept { return this->next != nullptr; }
+
+    /// Take the object out of whatever list holds it. Only valid with AutoUnlink or
+    /// through IntrusiveList::remove, which keeps the list's size right.
+    void unlink() noexcept
+    {
+        if (!is_linked())
+            return;
+        this->prev->next = this->next;
+        this->next->prev = this->prev;
+        this->next = this->prev = nullptr;
+    }
+};
+
+/// Doubly linked list of objects that carry their own ListHook, named by the member
+/// pointer Hook. The list never allocates, copies or destroys objects: push, erase and
+/// splice only rewrite links, and an object can be erased in O(1) given a reference to
+/// it. Debug builds abort on inserting an object that is already linked.
+template<typename T, auto Hook>
+struct IntrusiveList
+{
+    using HookType = std::remove_cvref_t<decltype(std::declval<T &>().*Hook)>;
+
+    static_assert(std::is_same_v<HookType, ListHook<HookType::mode>>,
+                  "Hook must name a ListHook member of T");
+
+    static constexpr bool kAutoUnlink = HookType::mode == HookMode::AutoUnlink;
+
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = T *;
+    using const_pointer   = const T *;
+    using reference       = T &;
+    using const_reference = const T &;
+
+  private:
+    using Node = ListBaseNode<HookType>;
+
+    Node mDummy;
+    std::size_t mSize = 0;   // unused with AutoUnlink: hooks leave without telling us
+
+    static std::ptrdiff_t hookOffset() noexcept
+    {
+        // the compiler folds this to the member's constant offset
+        alignas(T) unsigned char probe[sizeof(T)];
+        auto *obj = reinterpret_cast<T *>(probe);
+        return reinterpret_cast<unsigned char *>(&(obj->*Hook)) - probe;
+    }
+
+    static T *toObject(Node *node) noexcept
+    {
+        auto *hook = static_cast<HookType *>(node);
+        return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(hook) -
+                                     hookOffset());
+    }
+
+    static const T *toObject(const Node *node) noexcept
+    {
+        return toObject(const_cast<Node *>(node));
+    }
+
+    static Node *toNode(T &value) noexcept { return &(value.*Hook); }
+
+    static void linkBefore(Node *pos, Node *node) noexcept
+    {
+        Node *prev = pos->prev;
+        node->prev = prev;
+        node->next = pos;
+        prev->next = node;
+        pos->prev  = node;
+    }
+
+    static void unlinkNode(Node *node) noexcept
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        node->next = node->prev = nullptr;
+    }
+
+    void resetDummy() noexcept { mDummy.next = mDummy.prev = &mDummy; }
+
+  public:
+    IntrusiveList() noexcept { resetDummy(); }
+
+    IntrusiveList(const IntrusiveList &)            = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    IntrusiveList(IntrusiveList &&that) noexcept
+    {
+        resetDummy();
+        splice(end(), that);
+    }
+
+    IntrusiveList &operator=(IntrusiveList &&that) noexcept
+    {
+        if (&that != this) [[likely]]
+        {
+            clear();
+            splice(end(), that);
+        }
+        return *this;
+    }
+
+    /// Unlinks every object; none is destroyed.
+    ~IntrusiveList() noexcept { clear(); }
+
+    bool empty() const noexcept { return mDummy.next == &mDummy; }
+
+    /// O(1), or O(n) with AutoUnlink hooks.
+    std::size_t size() const noexcept
+    {
+        if constexpr (kAutoUnlink)
+            return static_cast<std::size_t>(std::distance(begin(), end()));
+        else
+            return mSize;
+    }
+
+    T &front() noexcept { return *toObject(mDummy.next); }
+
+    const T &front() const noexcept { return *toObject(mDummy.next); }
+
+    T &back() noexcept { return *toObject(mDummy.prev); }
+
+    const T &back() const noexcept { return *toObject(mDummy.prev); }
+
+    struct iterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+
+      private:
+        Node *mCurr;
+
+        friend IntrusiveList;
+
+        explicit iterator(Node *curr) noexcept : mCurr(curr) { }
+
+      public:
+        iterator() = default;
+
+        // ++iterator
+        iterator &operator++() noexcept
+        {
+            mCurr = mCurr->next;
+            return *this;
+        }
+
+        // iterator++
+        iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // --iterator
+        iterator &operator--() noexcept
+        {
+            mCurr = mCurr->prev;
+            return *this;
+        }
+
+        // iterator--
+        iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        T &operator*() const noexcept { return *toObject(mCurr); }
+
+        T *operator->() const noexcept { return toObject(mCurr); }
+
+        bool operator==(const iterator &that) const noexcept
+        {
+            return mCurr == that.mCurr;
+        }
+
+        bool operator!=(const iterator &that) const noexcept { return !(*this == that); }
+    };
+
+    struct const_iterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T *;
+        using reference         = const T &;
+
+      private:
+        const Node *mCurr;
+
+        friend IntrusiveList;
+
+        explicit const_iterator(const Node *curr) noexcept : mCurr(curr) { }
+
+      public:
+        const_iterator() = default;
+
+        const_iterator(iterator that) noexcept : mCurr(that.mCurr) { }
+
+        explicit operator iterator() noexcept
+        {
+            return iterator {const_cast<Node *>(mCurr)};
+        }
+
+        // ++iterator
+        const_iterator &operator++() noexcept
+        {
+            mCurr = mCurr->next;
+            return *this;
+        }
+
+        // iterator++
+        const_iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // --iterator
+        const_iterator &operator--() noexcept
+        {
+            mCurr = mCurr->prev;
+            return *this;
+        }
+
+        // iterator--
+        const_iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        const T &operator*() const noexcept { return *toObject(mCurr); }
+
+        const T *operator->() const noexcept { return toObject(mCurr); }
+
+        bool operator==(const const_iterator &that) const noexcept
+        {
+            return mCurr == that.mCurr;
+        }
+
+        bool operator!=(const const_iterator &that) const noexcept
+        {
+            return !(*this == that);
+        }
+    };
+
+    iterator begin() noexcept { return iterator {mDummy.next}; }
+
+    iterator end() noexcept { return iterator {&mDummy}; }
+
+    const_iterator cbegin() const noexcept { return const_iterator {mDummy.next}; }
+
+    const_iterator cend() const noexcept { return const_iterator {&mDummy}; }
+
+    const_iterator begin() const noexcept { return cbegin(); }
+
+    const_iterator end() const noexcept { return cend(); }
+
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return std::make_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return std::make_reverse_iterator(begin());
+    }
+
+    /// Iterator to an object known to be in this list. O(1).
+    iterator iterator_to(T &value) noexcept { return iterator {toNode(value)}; }
+
+    const_iterator iterator_to(const T &value) const noexcept
+    {
+        return const_iterator {toNode(const_cast<T &>(value))};
+    }
+
+    iterator insert(const_iterator pos, T &value) noexcept
+    {
+        Node *node = toNode(value);
+        _LIBPOWERCXX_INTRUSIVE_CHECK(!static_cast<HookType *>(node)->is_linked(),
+                                     "inserting an object that is already linked");
+        linkBefore(const_cast<Node *>(pos.mCurr), node);
+        ++mSize;
+        return iterator {node};
+    }
+
+    void push_back(T &value) noexcept { insert(cend(), value); }
+
+    void push_front(T &value) noexcept { insert(cbegin(), value); }
+
+    iterator erase(const_iterator pos) noexcept
+    {
+        Node *node = const_cast<Node *>(pos.mCurr);
+        Node *next = node->next;
+        unlinkNode(node);
+        --mSize;
+        return iterator {next};
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        while (first != last)
+            first = erase(first);
+        return iterator(first);
+    }
+
+    /// Unlink an object known to be in this list. O(1).
+    void remove(T &value) noexcept { erase(iterator_to(value)); }
+
+    void pop_front() noexcept { erase(cbegin()); }
+
+    void pop_back() noexcept { erase(std::prev(cend())); }
+
+    void clear() noexcept
+    {
+        Node *curr = mDummy.next;
+        while (curr != &mDummy)
+        {
+            Node *next = curr->next;
+            curr->next = curr->prev = nullptr;
+            curr                    = next;
+        }
+        resetDummy();
+        mSize = 0;
+    }
+
+    /// Move every object of that before pos. O(1).
+    void splice(const_iterator pos, IntrusiveList &that) noexcept
+    {
+        if (&that == this || that.empty())
+            return;
+
+        Node *next  = const_cast<Node *>(pos.mCurr);
+        Node *prev  = next->prev;
+        Node *first = that.mDummy.next;
+        Node *last  = that.mDummy.prev;
+
+        prev->next  = first;
+        first->prev = prev;
+        last->next  = next;
+        next->prev  = last;
+
+        mSize += that.mSize;
+        that.resetDummy();
+        that.mSize = 0;
+    }
+
+    /// Move one object of that before pos. O(1).
+    void splice(const_iterator pos, IntrusiveList &that, const_iterator it) noexcept
+    {
+        Node *node = const_cast<Node *>(it.mCurr);
+        if (node == pos.mCurr || node->next == pos.mCurr)
+            return;
+
+        unlinkNode(node);
+        --that.mSize;
+        linkBefore(const_cast<Node *>(pos.mCurr), node);
+        ++mSize;
+    }
+};
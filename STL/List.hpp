@@ -1,13 +1,19 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <type_traits>
 #include <utility>
+
+#include "Vector.hpp"
 #ifdef NDEBUG
     #define DEBUG_INIT_DEADBEAF(T)
 #else
@@ -65,15 +71,158 @@ struct List
     using AllocNode =
             std::allocator_traits<Alloc>::template rebind_alloc<ListValueNode<T>>;
 
+    // allocators that declare single_node_only, such as NodePoolAllocator, send every
+    // allocation of more than one node elsewhere
+    static constexpr bool kSingleNodeOnly =
+            requires { requires AllocNode::single_node_only::value; };
+
+    /// Nodes allocated together, by compact() and bulk inserts, in one allocator call
+    /// with this header in the first slots. A block is freed once its last node is, so
+    /// a few surviving nodes keep all of it: live counts its nodes, refs the lists that
+    /// list it in mBlocks, as splice can spread its nodes over several lists.
+    struct NodeBlock
+    {
+        std::atomic<std::size_t> live;
+        std::atomic<std::size_t> refs;
+        std::size_t slots;   // header included
+    };
+
+    static constexpr std::size_t kBlockHeaderSlots =
+            (sizeof(NodeBlock) + sizeof(ListValueNode<T>) - 1) / sizeof(ListValueNode<T>);
+
+    // a node pool rebound to NodeBlock * would set up a second pool for the registry
+    // alone, so those lists keep it with std::allocator
+    using AllocBlockPtr = std::conditional_t<
+            kSingleNodeOnly,
+            std::allocator<NodeBlock *>,
+            typename std::allocator_traits<Alloc>::template rebind_alloc<NodeBlock *>>;
+
+    static AllocBlockPtr registryAllocator(const AllocNode &alloc) noexcept
+    {
+        if constexpr (kSingleNodeOnly)
+            return AllocBlockPtr();
+        else
+            return AllocBlockPtr(alloc);
+    }
+
     ListNode mDummy;
     std::size_t mSize;
-    [[no_unique_address]] Alloc mAlloc;
+    // keep the rebound allocator itself, so a stateful one (e.g. a node pool) persists
+    [[no_unique_address]] AllocNode mAlloc;
+    // sorted by address; empty unless blocks are in use
+    Vector<NodeBlock *, AllocBlockPtr> mBlocks {registryAllocator(mAlloc)};
 
-    ListNode *newNode() { return AllocNode {mAlloc}.allocate(1); }
+    ListNode *newNode() { return mAlloc.allocate(1); }
 
     void deleteNode(ListNode *node) noexcept
     {
-        AllocNode {mAlloc}.deallocate(static_cast<ListValueNode<T> *>(node), 1);
+        if (!mBlocks.empty()) [[unlikely]]
+        {
+            if (NodeBlock *block = blockOf(node))
+            {
+                if (block->live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    dropBlock(block);
+                return;
+            }
+        }
+        mAlloc.deallocate(static_cast<ListValueNode<T> *>(node), 1);
+    }
+
+    static ListValueNode<T> *blockNodes(NodeBlock *block) noexcept
+    {
+        return reinterpret_cast<ListValueNode<T> *>(block) + kBlockHeaderSlots;
+    }
+
+    /// Allocate a block of n nodes, none live yet, and register it with this list.
+    NodeBlock *newBlock(std::size_t n)
+    {
+        std::size_t slots     = kBlockHeaderSlots + n;
+        ListValueNode<T> *raw = mAlloc.allocate(slots);
+        auto *block           = ::new (static_cast<void *>(raw)) NodeBlock;
+        block->live.store(0, std::memory_order_relaxed);
+        block->refs.store(1, std::memory_order_relaxed);
+        block->slots = slots;
+        try
+        {
+            addBlock(block);
+        }
+        catch (...)
+        {
+            freeBlock(block);
+            throw;
+        }
+        return block;
+    }
+
+    void freeBlock(NodeBlock *block) noexcept
+    {
+        std::size_t slots = block->slots;
+        std::destroy_at(block);
+        mAlloc.deallocate(reinterpret_cast<ListValueNode<T> *>(block), slots);
+    }
+
+    NodeBlock **findBlock(const void *addr) noexcept
+    {
+        auto key = reinterpret_cast<std::uintptr_t>(addr);
+        return std::upper_bound(mBlocks.begin(),
+                                mBlocks.end(),
+                                key,
+                                [](std::uintptr_t a, NodeBlock *b) {
+                                    return a < reinterpret_cast<std::uintptr_t>(b);
+                                });
+    }
+
+    /// The block holding node, or nullptr for a node allocated on its own.
+    NodeBlock *blockOf(const ListNode *node) noexcept
+    {
+        NodeBlock **it = findBlock(node);
+        if (it == mBlocks.begin())
+            return nullptr;
+        NodeBlock *block = it[-1];
+        auto *end        = reinterpret_cast<ListValueNode<T> *>(block) + block->slots;
+        return static_cast<const void *>(node) < static_cast<const void *>(end) ? block
+                                                                               : nullptr;
+    }
+
+    void addBlock(NodeBlock *block)
+    {
+        mBlocks.insert(findBlock(block), block);
+    }
+
+    /// Forget block; the last list to do so frees it.
+    void dropBlock(NodeBlock *block) noexcept
+    {
+        mBlocks.erase(findBlock(block) - 1);
+        if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            freeBlock(block);
+    }
+
+    /// Register block, whose nodes are moving in from another list, unless known.
+    void shareBlock(NodeBlock *block)
+    {
+        NodeBlock **it = findBlock(block);
+        if (it != mBlocks.begin() && it[-1] == block)
+            return;
+        mBlocks.insert(it, block);
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// that is handing over nodes that may come from any of its blocks. Room for all of
+    /// them is made first, so only that can throw, before any block is shared.
+    void shareBlocks(List &that)
+    {
+        if (that.mBlocks.empty())
+            return;
+        mBlocks.reserve(mBlocks.size() + that.mBlocks.size());
+        for (NodeBlock *block: that.mBlocks)
+            shareBlock(block);
+    }
+
+    /// Drop every block no node of this list can be in any more.
+    void dropBlocks() noexcept
+    {
+        while (!mBlocks.empty())
+            dropBlock(mBlocks.back());
     }
 
   public:
@@ -112,9 +261,10 @@ struct List
 
     List &operator=(List &&that)
     {
-        mAlloc = std::move(that.mAlloc);
         clear();
+        mAlloc = std::move(that.mAlloc);
         uninitMoveAssgin(std::move(that));
+        return *this;
     }
 
     List(const List &that) : mAlloc(that.mAlloc)
@@ -127,7 +277,12 @@ struct List
         uninitAssign(that.cbegin(), that.cend());
     }
 
-    List &operator=(const List &that) { assign(that.cbegin(), that.cend()); }
+    List &operator=(const List &that)
+    {
+        if (&that != this) [[likely]]
+            assign(that.cbegin(), that.cend());
+        return *this;
+    }
 
     // input_iterator = *it it++ ++it it!=it it==it
     // output_iterator = *it=val it++ ++it it!=it it==it
@@ -136,7 +291,7 @@ struct List
     // random_access_iterator = *it *it=val it[n] it[n]=val it++ ++it it-- --it it+=n it-=n it+n it-n it!=it it==it
 
     template <std::input_iterator InputIt>
-    List(InputIt first, InputIt last, const Alloc &alloc = Alloc())
+    List(InputIt first, InputIt last, const Alloc &alloc = Alloc()) : mAlloc(alloc)
     {
         uninitAssign(first, last);
     }
@@ -145,11 +300,15 @@ struct List
         : List(ilist.begin(), ilist.end(), alloc)
     { }
 
-    List &operator=(std::initializer_list<T> ilist) { assign(ilist); }
+    List &operator=(std::initializer_list<T> ilist)
+    {
+        assign(ilist);
+        return *this;
+    }
 
     ~List() noexcept { clear(); }
 
-    bool empty() noexcept { return mDummy.prev == mDummy.next; }
+    bool empty() const noexcept { return mSize == 0; }
 
     T &front() noexcept { return mDummy.next->value(); }
 
@@ -231,6 +390,8 @@ struct List
     void clear() noexcept
     {
         ListNode *curr = mDummy.next;
+        if (!mBlocks.empty()) [[unlikely]]
+            curr = clearBlocked(curr);
         while (curr != &mDummy)
         {
             std::destroy_at(&curr->value());
@@ -240,9 +401,128 @@ struct List
         }
         mDummy.prev = mDummy.next = &mDummy;
         mSize                     = 0;
+        dropBlocks();
     }
 
   private:
+    /// clear() for a list with NodeBlocks: neighbours usually share a block, so count
+    /// them off the block in one go rather than search for it node by node. Returns
+    /// the end, or where no block is left to look up.
+    ListNode *clearBlocked(ListNode *curr) noexcept
+    {
+        NodeBlock *block  = nullptr;
+        std::uintptr_t lo = 0, hi = 0;   // the block's address range
+        std::size_t run   = 0;   // nodes of block cleared but not yet counted off
+        auto flush = [&] {
+            if (run && block->live.fetch_sub(run, std::memory_order_acq_rel) == run)
+                dropBlock(block);
+            run = 0;
+        };
+
+        for (; curr != &mDummy && !mBlocks.empty();)
+        {
+            std::destroy_at(&curr->value());
+            ListNode *next = curr->next;
+            auto addr = reinterpret_cast<std::uintptr_t>(curr);
+            if (!block || addr < lo || addr >= hi)
+            {
+                flush();
+                block = blockOf(curr);
+                if (block)
+                {
+                    lo = reinterpret_cast<std::uintptr_t>(block);
+                    hi = lo + block->slots * sizeof(ListValueNode<T>);
+                }
+            }
+            if (block)
+                ++run;
+            else
+                mAlloc.deallocate(static_cast<ListValueNode<T> *>(curr), 1);
+            curr = next;
+        }
+        flush();
+        return curr;
+    }
+
+    /// Unlink [first, last) from wherever it is and relink it before pos, which must
+    /// not lie inside the range.
+    static void transfer(ListNode *pos, ListNode *first, ListNode *last) noexcept
+    {
+        if (first == last || pos == first || pos == last)
+            return;
+
+        ListNode *tail    = last->prev;
+        first->prev->next = last;
+        last->prev        = first->prev;
+
+        ListNode *before = pos->prev;
+        before->next     = first;
+        first->prev      = before;
+        tail->next       = pos;
+        pos->prev        = tail;
+    }
+
+    /// Merge two null-terminated sorted chains through next only into a, leaving b
+    /// empty; a wins ties. If comp throws, a still holds every node of both, unsorted.
+    template <typename Compare>
+    static void mergeRuns(ListNode *&a, ListNode *&b, Compare &comp)
+    {
+        ListNode head;
+        ListNode *tail = &head;
+        try
+        {
+            while (a && b)
+            {
+                if (comp(b->value(), a->value()))
+                {
+                    tail->next = b;
+                    b          = b->next;
+                }
+                else
+                {
+                    tail->next = a;
+                    a          = a->next;
+                }
+                tail = tail->next;
+            }
+        }
+        catch (...)
+        {
+            tail->next = a;
+            a          = joinChains(head.next, std::exchange(b, nullptr));
+            throw;
+        }
+        tail->next = a ? a : b;
+        a          = head.next;
+        b          = nullptr;
+    }
+
+    /// Append null-terminated chain b to chain a; O(length of a).
+    static ListNode *joinChains(ListNode *a, ListNode *b) noexcept
+    {
+        if (!a)
+            return b;
+        ListNode *tail = a;
+        while (tail->next)
+            tail = tail->next;
+        tail->next = b;
+        return a;
+    }
+
+    /// Make the null-terminated chain the whole list, rebuilding the prev links.
+    void relinkChain(ListNode *chain) noexcept
+    {
+        ListNode *prev = &mDummy;
+        for (ListNode *curr = chain; curr; curr = curr->next)
+        {
+            prev->next = curr;
+            curr->prev = prev;
+            prev       = curr;
+        }
+        prev->next  = &mDummy;
+        mDummy.prev = prev;
+    }
+
     void uninitMoveAssgin(List &&that)
     {
         auto prevNode = that.mDummy.prev;
@@ -254,65 +534,150 @@ struct List
         that.mDummy.prev = that.mDummy.next = &that.mDummy;
         mSize                               = that.mSize;
         that.mSize                          = 0;
+        mBlocks.swap(that.mBlocks);
     }
 
     template <std::input_iterator InputIt>
     void uninitAssign(InputIt first, InputIt last)
     {
-        mSize          = 0;
-        ListNode *prev = &mDummy;
-        while (first != last)
-        {
-            ListNode *node = newNode();
-            prev->next     = node;
-            node->prev     = prev;
-            std::construct_at(&node->value(), *first);
-            prev = node;
-            ++first;
-            ++mSize;
-        }
-        mDummy.prev = prev;
-        prev->next  = &mDummy;
+        mSize       = 0;
+        mDummy.prev = mDummy.next = &mDummy;
+        insertRange(&mDummy, first, last);
     }
 
     void uninitAssign(std::size_t n)
     {
-        ListNode *prev = &mDummy;
-        while (n)
-        {
-            ListNode *node = newNode();
-            prev->next     = node;
-            node->prev     = prev;
-            std::construct_at(&node->value());
-            prev = node;
-            --n;
-        }
-
-        mDummy.prev = prev;
-        prev->next  = &mDummy;
-        mSize       = n;
+        mSize       = 0;
+        mDummy.prev = mDummy.next = &mDummy;
+        insertBulk(&mDummy, n, [](T *p) { std::construct_at(p); });
     }
 
     void uninitAssign(std::size_t n, const T &value)
     {
-        ListNode *prev = &mDummy;
-        while (n)
+        mSize       = 0;
+        mDummy.prev = mDummy.next = &mDummy;
+        insertBulk(&mDummy, n, [&](T *p) { std::construct_at(p, value); });
+    }
+
+    static constexpr std::size_t kBulkMinNodes = 16;   // fewer are allocated one by one
+
+    // a block stays allocated while any of its nodes lives, so each one is kept to
+    // kBulkMaxBlockBytes: that is all a single survivor of a bulk insert can pin
+    static constexpr std::size_t kBulkMaxBlockBytes = 64 * 1024;
+    static constexpr std::size_t kBulkMaxBlock =
+            std::max(kBulkMinNodes,
+                     kBulkMaxBlockBytes / sizeof(ListValueNode<T>) - kBlockHeaderSlots);
+
+    // bulk inserts leave single_node_only allocators node by node
+    static constexpr bool kBulkBlocks = !kSingleNodeOnly;
+
+    /// Link n new nodes before pos, the i-th built by construct(&value), and return the
+    /// first (pos if n is 0). From kBulkMinNodes on, nodes come from NodeBlocks of up to
+    /// kBulkMaxBlock nodes: one allocator call per block instead of per node, and the
+    /// new elements sit next to each other in memory. The chain is built apart and
+    /// linked in at the end, so a throwing construct leaves the list as it was.
+    template <typename Construct>
+    ListNode *insertBulk(ListNode *pos, std::size_t n, Construct &&construct)
+    {
+        if (n == 0)
+            return pos;
+
+        ListNode head;
+        ListNode *tail         = &head;
+        NodeBlock *block       = nullptr;
+        ListValueNode<T> *slot = nullptr, *slotEnd = nullptr;
+        std::size_t built      = 0;   // in block; no other list can see it yet
+        try
         {
-            ListNode *node = newNode();
-            prev->next     = node;
-            node->prev     = prev;
-            std::construct_at(&node->value(), value);
-            prev = node;
-            --n;
+            for (std::size_t i = 0; i != n; i++)
+            {
+                ListNode *node;
+                if (kBulkBlocks && n >= kBulkMinNodes)
+                {
+                    if (slot == slotEnd)
+                    {
+                        if (block)
+                            block->live.store(built, std::memory_order_relaxed);
+                        std::size_t count = std::min(n - i, kBulkMaxBlock);
+                        block             = newBlock(count);
+                        slot              = blockNodes(block);
+                        slotEnd           = slot + count;
+                        built             = 0;
+                    }
+                    node = slot;
+                    construct(&node->value());
+                    ++built;
+                    ++slot;
+                }
+                else
+                {
+                    node = newNode();
+                    try
+                    {
+                        construct(&node->value());
+                    }
+                    catch (...)
+                    {
+                        mAlloc.deallocate(static_cast<ListValueNode<T> *>(node), 1);
+                        throw;
+                    }
+                }
+                tail->next = node;
+                node->prev = tail;
+                tail       = node;
+            }
+        }
+        catch (...)
+        {
+            // a block none of whose nodes got built is not freed by deleteNode below
+            if (block && built == 0)
+                dropBlock(block);
+            else if (block)
+                block->live.store(built, std::memory_order_relaxed);
+            tail->next = nullptr;
+            for (ListNode *node = head.next; node;)
+            {
+                ListNode *next = node->next;
+                std::destroy_at(&node->value());
+                deleteNode(node);
+                node = next;
+            }
+            throw;
         }
+        if (block)
+            block->live.store(built, std::memory_order_relaxed);
+
+        ListNode *prev  = pos->prev;
+        prev->next      = head.next;
+        head.next->prev = prev;
+        tail->next      = pos;
+        pos->prev       = tail;
+        mSize += n;
+        return head.next;
+    }
 
-        mDummy.prev = prev;
-        prev->next  = &mDummy;
-        mSize       = n;
+    /// insertBulk for a sized range; input-only ranges go one element at a time.
+    template <std::input_iterator InputIt>
+    ListNode *insertRange(ListNode *pos, InputIt first, InputIt last)
+    {
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            auto n = static_cast<std::size_t>(std::distance(first, last));
+            return insertBulk(pos, n, [&](T *p) {
+                std::construct_at(p, *first);
+                ++first;
+            });
+        }
+        else
+        {
+            ListNode *before = pos->prev;
+            for (; first != last; ++first)
+                emplace(const_iterator {pos}, *first);
+            return before->next;
+        }
     }
 
   public:
-
     struct iterator
     {
         using iterator_category = std::bidirectional_iterator_tag;
@@ -328,6 +693,9 @@ struct List
 
         explicit iterator(ListNode *curr) noexcept : mCurr(curr) { }
 
+      public:
+        iterator() = default;
+
         // ++iterator
         iterator &operator++() noexcept
         {
@@ -408,18 +776,18 @@ struct List
             return tmp;
         }
 
-        // iterator++
+        // --iterator
         const_iterator &operator--() noexcept
         {
-            mCurr = mCurr->next;
+            mCurr = mCurr->prev;
             return *this;
         }
 
-        // --iterator
+        // iterator--
         const_iterator operator--(int) noexcept
         {
             auto tmp = *this;
-            ++(*this);
+            --(*this);
             return tmp;
         }
 
@@ -438,11 +806,11 @@ struct List
 
     iterator begin() noexcept { return iterator {mDummy.next}; }
 
-    iterator end() noexcept { return iterator {mDummy.prev}; }
+    iterator end() noexcept { return iterator {&mDummy}; }
 
     const_iterator cbegin() const noexcept { return const_iterator {mDummy.next}; }
 
-    const_iterator cend() const noexcept { return const_iterator {mDummy.prev}; }
+    const_iterator cend() const noexcept { return const_iterator {&mDummy}; }
 
     const_iterator begin() const noexcept { return cbegin(); }
 
@@ -478,6 +846,7 @@ struct List
         next->prev     = prev;
 
         std::destroy_at(&node->value());
+        deleteNode(node);
         --mSize;
         return iterator {next};
     }
@@ -496,7 +865,7 @@ struct List
     std::size_t remove(const T &value) noexcept
     {
         auto first = begin();
-        auto last  = begin();
+        auto last  = end();
 
         std::size_t count = 0;
         while (first != last)
@@ -519,7 +888,7 @@ struct List
     std::size_t remove_if(Predict &&pred) noexcept
     {
         auto first = begin();
-        auto last  = begin();
+        auto last  = end();
 
         std::size_t count = 0;
         while (first != last)
@@ -563,60 +932,285 @@ struct List
         return emplace(pos, std::move(value));
     }
 
+    /// Sized inserts allocate their nodes together; see insertBulk.
     iterator insert(const_iterator pos, std::size_t n, const T &value)
     {
-        auto origin    = pos;
-        bool hadOrigin = false;
+        return iterator {insertBulk(const_cast<ListNode *>(pos.mCurr), n, [&](T *p) {
+            std::construct_at(p, value);
+        })};
+    }
+
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        return iterator {insertRange(const_cast<ListNode *>(pos.mCurr), first, last)};
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist)
+    {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    // splice, merge, sort, unique and reverse only relink nodes: no element is
+    // allocated, copied or moved, and iterators to the moved elements stay valid.
+    // Splicing between lists requires equal allocators. Nodes a compacted list hands
+    // to another make it track their block, which can allocate: splice and merge from
+    // such a list may throw bad_alloc, and then do so before any node has moved.
 
-        while (n)
+    /// Move all of that's elements before pos. O(1).
+    void splice(const_iterator pos, List &that)
+    {
+        if (&that == this) [[unlikely]]
+            return;
+        shareBlocks(that);
+        transfer(const_cast<ListNode *>(pos.mCurr), that.mDummy.next, &that.mDummy);
+        mSize += that.mSize;
+        that.mSize = 0;
+        that.dropBlocks();
+    }
+
+    void splice(const_iterator pos, List &&that) { splice(pos, that); }
+
+    /// Move the element at it from that before pos. O(1).
+    void splice(const_iterator pos, List &that, const_iterator it)
+    {
+        ListNode *node = const_cast<ListNode *>(it.mCurr);
+        if (&that != this && !that.mBlocks.empty()) [[unlikely]]
+        {
+            if (NodeBlock *block = that.blockOf(node))
+                shareBlock(block);
+        }
+        transfer(const_cast<ListNode *>(pos.mCurr), node, node->next);
+        that.mSize -= 1;
+        mSize += 1;
+    }
+
+    void splice(const_iterator pos, List &&that, const_iterator it)
+    {
+        splice(pos, that, it);
+    }
+
+    /// Move [first, last) from that before pos. O(1) within one list, otherwise linear
+    /// in the range length, which has to be counted for size().
+    void splice(const_iterator pos, List &that, const_iterator first, const_iterator last)
+    {
+        if (&that != this)
         {
-            pos = emplace(pos, value);
-            if (!hadOrigin)
+            shareBlocks(that);
+            std::size_t n = std::distance(first, last);
+            that.mSize -= n;
+            mSize += n;
+        }
+        transfer(const_cast<ListNode *>(pos.mCurr),
+                 const_cast<ListNode *>(first.mCurr),
+                 const_cast<ListNode *>(last.mCurr));
+    }
+
+    void splice(const_iterator pos,
+                List &&that,
+                const_iterator first,
+                const_iterator last)
+    {
+        splice(pos, that, first, last);
+    }
+
+    /// Merge the sorted list that into this sorted list; stable, that ends up empty.
+    template <typename Compare = std::less<>>
+    void merge(List &that, Compare comp = Compare())
+    {
+        if (&that == this) [[unlikely]]
+            return;
+
+        shareBlocks(that);
+        ListNode *first1 = mDummy.next;
+        ListNode *first2 = that.mDummy.next;
+        while (first1 != &mDummy && first2 != &that.mDummy)
+        {
+            if (comp(first2->value(), first1->value()))
             {
-                hadOrigin = true;
-                origin    = pos;
+                // move the whole run of that's elements that go before first1
+                ListNode *last2 = first2->next;
+                std::size_t n   = 1;
+                while (last2 != &that.mDummy && comp(last2->value(), first1->value()))
+                {
+                    last2 = last2->next;
+                    ++n;
+                }
+                transfer(first1, first2, last2);
+                that.mSize -= n;   // kept exact run by run, in case comp throws
+                mSize += n;
+                first2 = last2;
+            }
+            else
+            {
+                first1 = first1->next;
             }
-            ++pos;
-            --n;
         }
+        transfer(&mDummy, first2, &that.mDummy);
+        mSize += that.mSize;
+        that.mSize = 0;
+        that.dropBlocks();
+    }
 
-        return iterator(origin);
+    template <typename Compare = std::less<>>
+    void merge(List &&that, Compare comp = Compare())
+    {
+        merge(that, comp);
     }
 
-    template <std::input_iterator InputIt>
-    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    /// Stable bottom-up merge sort. Nodes are sorted as a singly linked chain, merging
+    /// runs of 1, 2, 4, ... nodes held in bins, and the prev links are rebuilt in one
+    /// final pass. O(n log n) comparisons, no allocation. If comp throws, every element
+    /// stays in the list, in unspecified order.
+    template <typename Compare = std::less<>>
+    void sort(Compare comp = Compare())
     {
-        auto origin    = pos;
-        bool hadOrigin = false;
+        if (mSize < 2)
+            return;
+
+        // bins[k] is empty or a sorted run of 2^k nodes, older than the lower bins;
+        // node, run, sorted and the bins never share a node, so a throw can join them
+        ListNode *bins[64] = {};
+        mDummy.prev->next  = nullptr;
+        ListNode *node     = mDummy.next;
+        ListNode *run = nullptr, *sorted = nullptr;
+        try
+        {
+            while (node)
+            {
+                run       = node;
+                node      = node->next;
+                run->next = nullptr;
+
+                std::size_t k = 0;
+                for (; bins[k]; k++)
+                {
+                    mergeRuns(bins[k], run, comp);
+                    run = std::exchange(bins[k], nullptr);
+                }
+                bins[k] = std::exchange(run, nullptr);
+            }
 
-        while (first != last)
+            for (ListNode *&bin: bins)
+                if (bin)
+                {
+                    if (sorted)
+                        mergeRuns(bin, sorted, comp);
+                    sorted = std::exchange(bin, nullptr);
+                }
+        }
+        catch (...)
         {
-            pos = emplace(pos, *first);
-            if (!hadOrigin)
+            ListNode *all = joinChains(node, joinChains(run, sorted));
+            for (ListNode *bin: bins)
+                all = joinChains(bin, all);
+            relinkChain(all);
+            throw;
+        }
+        relinkChain(sorted);
+    }
+
+    /// Erase every element equal (by pred) to the one before it; returns how many.
+    template <typename BinaryPredicate = std::equal_to<>>
+    std::size_t unique(BinaryPredicate pred = BinaryPredicate())
+    {
+        std::size_t count = 0;
+        if (mSize < 2)
+            return count;
+
+        ListNode *curr = mDummy.next;
+        while (curr->next != &mDummy)
+        {
+            if (pred(curr->value(), curr->next->value()))
             {
-                hadOrigin = true;
-                origin    = pos;
+                erase(const_iterator {curr->next});
+                ++count;
+            }
+            else
+            {
+                curr = curr->next;
             }
-            ++pos;
-            ++first;
         }
+        return count;
+    }
 
-        return iterator(origin);
+    void reverse() noexcept
+    {
+        ListNode *curr = &mDummy;
+        do
+        {
+            std::swap(curr->next, curr->prev);
+            curr = curr->prev;   // the old next
+        } while (curr != &mDummy);
     }
 
-    iterator insert(const_iterator pos, std::initializer_list<T> ilist)
+    /// Move every element into one freshly allocated block of nodes, in traversal
+    /// order, and free the old nodes. Traversal then walks memory sequentially however
+    /// scattered insert and erase had left the nodes. Invalidates every iterator,
+    /// pointer and reference into the list. Later erases still free nodes one by one;
+    /// the block itself is returned once all of its nodes are gone.
+    void compact()
     {
-        return insert(pos, ilist.begin(), ilist.end());
+        if (mSize)
+            compactFrom(mDummy.next, mSize);
+    }
+
+    /// Incremental compact(): move at most n elements, starting at from, into a new
+    /// block sized for them, and return where to continue (end() when done). Only
+    /// iterators to the moved elements are invalidated, so the list stays usable
+    /// between steps:
+    ///
+    ///     for (auto it = l.begin(); it != l.end();)
+    ///         it = l.compact(it, 4096);   // a bounded amount of work per step
+    iterator compact(const_iterator from, std::size_t n)
+    {
+        return iterator {compactFrom(const_cast<ListNode *>(from.mCurr), n)};
     }
 
-    void splice(const_iterator pos, List &&that)
+  private:
+    ListNode *compactFrom(ListNode *curr, std::size_t n)
     {
-        insert(pos,
-               std::make_move_iterator(that.begin()),
-               std::make_move_iterator(that.end()));
+        if (curr == &mDummy || n == 0)
+            return curr;
+
+        std::size_t count = 0;   // no more nodes than are left to move
+        for (ListNode *node = curr; count != n && node != &mDummy; node = node->next)
+            ++count;
+
+        NodeBlock *block       = newBlock(count);
+        ListValueNode<T> *slot = blockNodes(block);
+        std::size_t moved      = 0;
+        try
+        {
+            for (; moved != count; moved++, slot++)
+            {
+                ListNode *node = slot;
+                std::construct_at(&node->value(), std::move_if_noexcept(curr->value()));
+
+                ListNode *next   = curr->next;
+                node->prev       = curr->prev;
+                node->next       = next;
+                node->prev->next = node;
+                next->prev       = node;
+                std::destroy_at(&curr->value());
+                deleteNode(curr);
+                curr = next;
+            }
+        }
+        catch (...)
+        {
+            if (moved == 0)
+                dropBlock(block);
+            else
+                block->live.store(moved, std::memory_order_relaxed);
+            throw;
+        }
+        block->live.store(moved, std::memory_order_relaxed);
+        return curr;
     }
 
-    Alloc get_allocator() const { return mAlloc; }
+  public:
+    Alloc get_allocator() const { return Alloc(mAlloc); }
 
     bool operator==(const List &that) noexcept
     {
@@ -0,0 +1,542 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "List.hpp"
+#include "Vector.hpp"
+
+enum class CachePolicy
+{
+    Lru,   // evict the least recently used entry
+    Lfu,   // evict the least frequently used entry, the oldest among equals
+};
+
+/// Charges every entry 1, so a cache's capacity is a number of entries.
+struct EntryCount
+{
+    template<typename K, typename V>
+    std::size_t operator()(const K &, const V &) const noexcept
+    {
+        return 1;
+    }
+};
+
+/// Charges an entry its approximate size in bytes: the key and value themselves plus
+/// the buffer of either one that has a capacity(), such as a string or a vector.
+struct EntryBytes
+{
+    template<typename K, typename V>
+    std::size_t operator()(const K &key, const V &value) const noexcept
+    {
+        return sizeof(K) + sizeof(V) + heapBytes(key) + heapBytes(value);
+    }
+
+  private:
+    template<typename T>
+    static std::size_t heapBytes(const T &x) noexcept
+    {
+        if constexpr (requires { typename T::value_type; x.capacity(); })
+            return x.capacity() * sizeof(typename T::value_type);
+        else
+            return 0;
+    }
+};
+
+/// Bounded key-value cache with O(1) get, put and eviction. Entries live in the slots
+/// of an open-addressing hash table (linear probing, backward-shift deletion, so no
+/// tombstones), and the eviction order is a List-style circular list threaded through
+/// those same slots: a hit relinks a node and allocates nothing. Weigher decides what
+/// the capacity counts. With EntryCount the table is sized once at construction; with
+/// EntryBytes or another weigher it grows while the cache warms up.
+///
+/// The Lfu list is sorted by use count. A bucket per distinct count marks where its run
+/// ends, so a hit moves the entry to the end of the next run in O(1).
+///
+/// put and erase may move entries between slots: a pointer from get, peek or put is
+/// valid until the next put or erase.
+template<typename K,
+         typename V,
+         CachePolicy Policy = CachePolicy::Lru,
+         typename Weigher   = EntryCount,
+         typename Hash      = std::hash<K>,
+         typename Eq        = std::equal_to<K>>
+struct BasicCache
+{
+    static_assert(std::is_nothrow_move_constructible_v<K> &&
+                          std::is_nothrow_move_constructible_v<V>,
+                  "BasicCache moves entries between slots and cannot undo a throw");
+
+    using key_type    = K;
+    using mapped_type = V;
+    using size_type   = std::size_t;
+
+  private:
+    static constexpr bool kLfu = Policy == CachePolicy::Lfu;
+
+    struct NoBucket
+    { };
+
+    struct Slot : ListBaseNode<Slot>
+    {
+        std::size_t hash;
+        std::size_t weight;
+        bool used = false;
+        [[no_unique_address]] std::conditional_t<kLfu, std::uint32_t, NoBucket> bucket;
+
+        union
+        {
+            K key;
+        };
+
+        union
+        {
+            V value;
+        };
+
+        Slot() noexcept { }
+
+        ~Slot() { }
+    };
+
+    using Node = ListBaseNode<Slot>;
+
+    /// A run of Lfu entries with the same use count, ending at last. A free bucket keeps
+    /// the index of the next free one in count.
+    struct Bucket
+    {
+        std::size_t freq;
+        Node *last;
+        std::uint32_t count;
+    };
+
+    static constexpr std::uint32_t kNoBucket = static_cast<std::uint32_t>(-1);
+
+    Slot *mSlots;
+    std::size_t mMask;
+    std::size_t mSize   = 0;
+    std::size_t mWeight = 0;
+    std::size_t mCapacity;
+    Node mDummy;
+    Slot *mPinned = nullptr;   // followed across slot moves while put evicts
+    Vector<Bucket> mBuckets;
+    std::uint32_t mFreeBucket = kNoBucket;
+    [[no_unique_address]] Weigher mWeigher;
+    [[no_unique_address]] Hash mHash;
+    [[no_unique_address]] Eq mEq;
+
+    static Slot *toSlot(Node *node) noexcept { return static_cast<Slot *>(node); }
+
+    /// Table size keeping the load at most 3/4 with entries + 1 entries, the extra one
+    /// being an insert that has not evicted yet.
+    static std::size_t slotsFor(std::size_t entries) noexcept
+    {
+        return std::bit_ceil(entries + entries / 3 + 2);
+    }
+
+    std::size_t hashOf(const K &key) const noexcept
+    {
+        // spread weak hashes (std::hash of an integer is the identity) over the low bits
+        std::size_t h = mHash(key) * static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+        return h ^ (h >> (sizeof(std::size_t) * 4));
+    }
+
+    Slot *find(const K &key, std::size_t h) const noexcept
+    {
+        for (std::size_t i = h & mMask;; i = (i + 1) & mMask)
+        {
+            Slot &slot = mSlots[i];
+            if (!slot.used)
+                return nullptr;
+            if (slot.hash == h && mEq(slot.key, key))
+                return &slot;
+        }
+    }
+
+    void allocateSlots(std::size_t n)
+    {
+        if constexpr (kLfu)
+            mBuckets.reserve(n);   // one bucket per entry at most: never reallocates
+        mSlots = std::allocator<Slot>().allocate(n);
+        for (std::size_t i = 0; i != n; i++)
+            std::construct_at(&mSlots[i]);
+        mMask = n - 1;
+    }
+
+    void freeSlots(Slot *slots, std::size_t n) noexcept
+    {
+        std::destroy_n(slots, n);
+        std::allocator<Slot>().deallocate(slots, n);
+    }
+
+    void resetDummy() noexcept { mDummy.next = mDummy.prev = &mDummy; }
+
+    static void linkAfter(Node *pos, Node *node) noexcept
+    {
+        Node *next = pos->next;
+        node->prev = pos;
+        node->next = next;
+        pos->next  = node;
+        next->prev = node;
+    }
+
+    static void unlinkNode(Node *node) noexcept
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+    }
+
+    std::uint32_t newBucket(std::size_t freq, Node *last) noexcept
+    {
+        std::uint32_t i = mFreeBucket;
+        if (i != kNoBucket)
+            mFreeBucket = mBuckets[i].count;
+        else
+        {
+            i = static_cast<std::uint32_t>(mBuckets.size());
+            mBuckets.push_back({});
+        }
+        mBuckets[i] = {freq, last, 1};
+        return i;
+    }
+
+    void freeBucket(std::uint32_t i) noexcept
+    {
+        mBuckets[i].count = mFreeBucket;
+        mFreeBucket       = i;
+    }
+
+    /// Take slot out of the eviction order, keeping its Lfu bucket consistent.
+    void unlinkSlot(Slot *slot) noexcept
+    {
+        if constexpr (kLfu)
+        {
+            Bucket &b = mBuckets[slot->bucket];
+            if (--b.count == 0)
+                freeBucket(slot->bucket);
+            else if (b.last == slot)
+                b.last = slot->prev;
+        }
+        unlinkNode(slot);
+    }
+
+    /// Link a new entry: most recent for Lru, end of the use-count-1 run for Lfu.
+    void linkNew(Slot *slot) noexcept
+    {
+        if constexpr (kLfu)
+        {
+            Node *first = mDummy.next;
+            if (first != &mDummy && mBuckets[toSlot(first)->bucket].freq == 1)
+            {
+                Bucket &b = mBuckets[toSlot(first)->bucket];
+                linkAfter(b.last, slot);
+                b.last = slot;
+                b.count += 1;
+                slot->bucket = toSlot(first)->bucket;
+            }
+            else
+            {
+                linkAfter(&mDummy, slot);
+                slot->bucket = newBucket(1, slot);
+            }
+        }
+        else
+            linkAfter(mDummy.prev, slot);
+    }
+
+    void touch(Slot *slot) noexcept
+    {
+        if constexpr (kLfu)
+        {
+            Bucket &b        = mBuckets[slot->bucket];
+            std::size_t freq = b.freq + 1;
+            Node *after      = b.last->next;
+            if (after != &mDummy && mBuckets[toSlot(after)->bucket].freq == freq)
+            {
+                // join the end of the next run
+                std::uint32_t next = toSlot(after)->bucket;
+                Node *pos          = mBuckets[next].last;
+                unlinkSlot(slot);
+                linkAfter(pos, slot);
+                mBuckets[next].last = slot;
+                mBuckets[next].count += 1;
+                slot->bucket = next;
+            }
+            else if (b.count == 1)
+                b.freq = freq;   // alone in its run: the run itself moves up
+            else
+            {
+                // start a new run right after this one
+                b.count -= 1;
+                if (b.last == slot)
+                    b.last = slot->prev;
+                else
+                {
+                    Node *pos = b.last;
+                    unlinkNode(slot);
+                    linkAfter(pos, slot);
+                }
+                slot->bucket = newBucket(freq, slot);
+            }
+        }
+        else if (slot->next != &mDummy)
+        {
+            unlinkNode(slot);
+            linkAfter(mDummy.prev, slot);
+        }
+    }
+
+    /// Move the entry in from to the empty slot to, relinking its neighbours.
+    void moveSlot(Slot *from, Slot *to) noexcept
+    {
+        std::construct_at(&to->key, std::move(from->key));
+        std::construct_at(&to->value, std::move(from->value));
+        std::destroy_at(&from->value);
+        std::destroy_at(&from->key);
+        to->hash   = from->hash;
+        to->weight = from->weight;
+        to->bucket = from->bucket;
+        to->used   = true;
+        from->used = false;
+
+        to->prev       = from->prev;
+        to->next       = from->next;
+        to->prev->next = to;
+        to->next->prev = to;
+        if constexpr (kLfu)
+            if (mBuckets[to->bucket].last == from)
+                mBuckets[to->bucket].last = to;
+        if (mPinned == from)
+            mPinned = to;
+    }
+
+    void eraseSlot(Slot *slot) noexcept
+    {
+        unlinkSlot(slot);
+        mWeight -= slot->weight;
+        mSize -= 1;
+        std::destroy_at(&slot->value);
+        std::destroy_at(&slot->key);
+        slot->used = false;
+
+        // pull later entries of the probe run back into the hole
+        std::size_t hole = static_cast<std::size_t>(slot - mSlots);
+        for (std::size_t i = (hole + 1) & mMask; mSlots[i].used; i = (i + 1) & mMask)
+        {
+            std::size_t home = mSlots[i].hash & mMask;
+            if (((i - home) & mMask) >= ((i - hole) & mMask))
+            {
+                moveSlot(&mSlots[i], &mSlots[hole]);
+                hole = i;
+            }
+        }
+    }
+
+    /// Evict from the cold end until the weight fits, sparing mPinned.
+    void evictOver() noexcept
+    {
+        while (mWeight > mCapacity)
+        {
+            Node *victim = mDummy.next;
+            if (victim == mPinned)
+                victim = victim->next;
+            if (victim == &mDummy)
+                break;
+            eraseSlot(toSlot(victim));
+        }
+    }
+
+    void rehash(std::size_t n)
+    {
+        Slot *old          = mSlots;
+        std::size_t oldLen = mMask + 1;
+        allocateSlots(n);
+
+        // reinsert in eviction order, which rebuilds the list as it goes
+        Node *curr = mDummy.next;
+        resetDummy();
+        while (curr != &mDummy)
+        {
+            Node *next = curr->next;
+            Slot *from = toSlot(curr);
+            std::size_t i = from->hash & mMask;
+            while (mSlots[i].used)
+                i = (i + 1) & mMask;
+            from->prev = mDummy.prev;
+            from->next = &mDummy;
+            mDummy.prev->next = from;
+            mDummy.prev       = from;
+            moveSlot(from, &mSlots[i]);
+            curr = next;
+        }
+        freeSlots(old, oldLen);
+    }
+
+  public:
+    explicit BasicCache(std::size_t capacity,
+                        Weigher weigher = {},
+                        Hash hash       = {},
+                        Eq eq           = {})
+        : mCapacity(capacity),
+          mWeigher(std::move(weigher)),
+          mHash(std::move(hash)),
+          mEq(std::move(eq))
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("BasicCache capacity must be positive");
+        resetDummy();
+        allocateSlots(slotsFor(std::is_same_v<Weigher, EntryCount> ? capacity : 8));
+    }
+
+    BasicCache(const BasicCache &)            = delete;
+    BasicCache &operator=(const BasicCache &) = delete;
+
+    ~BasicCache() noexcept
+    {
+        clear();
+        freeSlots(mSlots, mMask + 1);
+    }
+
+    std::size_t size() const noexcept { return mSize; }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    /// Total charged by the weigher: the entry count under EntryCount.
+    std::size_t weight() const noexcept { return mWeight; }
+
+    std::size_t capacity() const noexcept { return mCapacity; }
+
+    /// The value for key, counting as a use; nullptr on a miss.
+    V *get(const K &key) noexcept
+    {
+        Slot *slot = find(key, hashOf(key));
+        if (!slot) [[unlikely]]
+            return nullptr;
+        touch(slot);
+        return &slot->value;
+    }
+
+    /// Like get, without counting as a use.
+    V *peek(const K &key) noexcept
+    {
+        Slot *slot = find(key, hashOf(key));
+        return slot ? &slot->value : nullptr;
+    }
+
+    const V *peek(const K &key) const noexcept
+    {
+        Slot *slot = find(key, hashOf(key));
+        return slot ? &slot->value : nullptr;
+    }
+
+    bool contains(const K &key) const noexcept { return find(key, hashOf(key)); }
+
+    /// Count a use of key without reading it; false if it is not cached.
+    bool touch(const K &key) noexcept
+    {
+        Slot *slot = find(key, hashOf(key));
+        if (slot)
+            touch(slot);
+        return slot;
+    }
+
+    /// Insert or overwrite key, count it as a use and evict until the weight fits.
+    /// The entry just put is never evicted, even if it alone is over capacity.
+    template<typename KK, typename VV>
+    V &put(KK &&key, VV &&value)
+    {
+        std::size_t h = hashOf(key);
+        Slot *slot    = find(key, h);
+        if (slot)
+        {
+            slot->value   = std::forward<VV>(value);
+            std::size_t w = mWeigher(slot->key, slot->value);
+            mWeight       = mWeight - slot->weight + w;
+            slot->weight  = w;
+            touch(slot);
+        }
+        else
+        {
+            if ((mSize + 1) * 4 > (mMask + 1) * 3) [[unlikely]]
+                rehash((mMask + 1) * 2);
+
+            std::size_t i = h & mMask;
+            while (mSlots[i].used)
+                i = (i + 1) & mMask;
+            slot = &mSlots[i];
+            std::construct_at(&slot->key, std::forward<KK>(key));
+            try
+            {
+                std::construct_at(&slot->value, std::forward<VV>(value));
+            }
+            catch (...)
+            {
+                std::destroy_at(&slot->key);
+                throw;
+            }
+            slot->hash   = h;
+            slot->weight = mWeigher(slot->key, slot->value);
+            slot->used   = true;
+            mWeight += slot->weight;
+            mSize += 1;
+            linkNew(slot);
+        }
+
+        mPinned = slot;
+        evictOver();
+        slot    = mPinned;
+        mPinned = nullptr;
+        return slot->value;
+    }
+
+    bool erase(const K &key) noexcept
+    {
+        Slot *slot = find(key, hashOf(key));
+        if (slot)
+            eraseSlot(slot);
+        return slot;
+    }
+
+    void clear() noexcept
+    {
+        for (Node *curr = mDummy.next; curr != &mDummy; curr = curr->next)
+        {
+            Slot *slot = toSlot(curr);
+            std::destroy_at(&slot->value);
+            std::destroy_at(&slot->key);
+            slot->used = false;
+        }
+        resetDummy();
+        mSize = mWeight = 0;
+        mBuckets.clear();
+        mFreeBucket = kNoBucket;
+    }
+
+    /// Visit every entry as fn(const K &, V &), from the next to be evicted onwards.
+    template<typename Fn>
+    void for_each(Fn &&fn)
+    {
+        for (Node *curr = mDummy.next; curr != &mDummy; curr = curr->next)
+            fn(std::as_const(toSlot(curr)->key), toSlot(curr)->value);
+    }
+};
+
+template<typename K,
+         typename V,
+         typename Weigher = EntryCount,
+         typename Hash    = std::hash<K>,
+         typename Eq      = std::equal_to<K>>
+using LruCache = BasicCache<K, V, CachePolicy::Lru, Weigher, Hash, Eq>;
+
+template<typename K,
+         typename V,
+         typename Weigher = EntryCount,
+         typename Hash    = std::hash<K>,
+         typename Eq      = std::equal_to<K>>
+using LfuCache = BasicCache<K, V, CachePolicy::Lfu, Weigher, Hash, Eq>;
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "VectorPolicy.hpp"
+
+enum class MapMode
+{
+    ReadWrite,     // changes and growth go to the file
+    ReadOnly,      // any mutation throws
+    CopyOnWrite,   // changes stay private to this process, the file is never written
+};
+
+/// Vector of trivially copyable T whose storage is a memory-mapped file, so a snapshot
+/// persists as-is and reopens without parsing. The file starts with a small header
+/// holding the element size, size and capacity, followed by the elements.
+template<typename T>
+struct MappedVector
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "MappedVector stores raw bytes, T must be trivially copyable");
+    static_assert(alignof(T) <= 64, "MappedVector aligns elements to 64 bytes");
+
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using iterator               = T *;
+    using const_iterator         = const T *;
+    using reverse_iterator       = std::reverse_iterator<T *>;
+    using const_reverse_iterator = std::reverse_iterator<const T *>;
+
+  private:
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint64_t elemSize;
+        std::uint64_t size;
+        std::uint64_t cap;
+    };
+
+    static constexpr std::uint64_t kMagic    = 0x524f5443'4556504dull;   // "MPVECTOR"
+    static constexpr std::size_t kDataOffset = 64;
+
+    int mFd;
+    MapMode mMode;
+    std::byte *mBase;
+    std::size_t mMapped;   // bytes currently mapped
+    bool mPrivateCopy;     // CopyOnWrite data moved to anonymous memory after growth
+
+  public:
+    explicit MappedVector(const std::string &path, MapMode mode = MapMode::ReadWrite)
+        : mFd(-1), mMode(mode), mBase(nullptr), mMapped(0), mPrivateCopy(false)
+    {
+        int flags = mode == MapMode::ReadWrite ? O_RDWR | O_CREAT : O_RDONLY;
+        mFd       = ::open(path.c_str(), flags, 0644);
+        if (mFd < 0)
+            throw std::runtime_error("MappedVector: cannot open " + path);
+
+        struct stat st;
+        if (::fstat(mFd, &st) != 0)
+            fail("MappedVector: cannot stat " + path);
+        std::size_t fileSize = static_cast<std::size_t>(st.st_size);
+
+        if (fileSize == 0 && mode == MapMode::ReadWrite)
+        {
+            fileSize = kDataOffset;
+            if (::ftruncate(mFd, static_cast<off_t>(fileSize)) != 0)
+                fail("MappedVector: cannot size " + path);
+            map(fileSize);
+            *header() = Header {kMagic, sizeof(T), 0, 0};
+            return;
+        }
+
+        if (fileSize < kDataOffset)
+            fail("MappedVector: " + path + " is not a MappedVector file");
+        map(fileSize);
+        if (header()->magic != kMagic || header()->elemSize != sizeof(T))
+            fail("MappedVector: " + path + " does not hold this element type");
+        // a truncated or corrupt header must not let elements run past the mapping
+        const Header &h = *header();
+        if (h.size > h.cap || h.cap > (fileSize - kDataOffset) / sizeof(T))
+            fail("MappedVector: " + path + " is truncated or corrupt");
+    }
+
+    MappedVector(const MappedVector &)            = delete;
+    MappedVector &operator=(const MappedVector &) = delete;
+
+    MappedVector(MappedVector &&that) noexcept
+        : mFd(std::exchange(that.mFd, -1)),
+          mMode(that.mMode),
+          mBase(std::exchange(that.mBase, nullptr)),
+          mMapped(std::exchange(that.mMapped, 0)),
+          mPrivateCopy(that.mPrivateCopy)
+    { }
+
+    MappedVector &operator=(MappedVector &&that) noexcept
+    {
+        if (&that == this) [[unlikely]]
+            return *this;
+
+        close();
+        mFd          = std::exchange(that.mFd, -1);
+        mMode        = that.mMode;
+        mBase        = std::exchange(that.mBase, nullptr);
+        mMapped      = std::exchange(that.mMapped, 0);
+        mPrivateCopy = that.mPrivateCopy;
+        return *this;
+    }
+
+    ~MappedVector() noexcept { close(); }
+
+    MapMode mode() const noexcept { return mMode; }
+
+    /// Flush dirty pages to the file (ReadWrite only) and wait for the write-back.
+    void sync()
+    {
+        if (mMode == MapMode::ReadWrite && ::msync(mBase, mMapped, MS_SYNC) != 0)
+            throw std::runtime_error("MappedVector: msync failed");
+    }
+
+    // a moved-from MappedVector maps nothing and is empty
+
+    std::size_t size() const noexcept { return mBase ? header()->size : 0; }
+
+    std::size_t capacity() const noexcept { return mBase ? header()->cap : 0; }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    void reserve(std::size_t n)
+    {
+        if (n <= capacity())
+            return;
+
+        checkWritable();
+        n = std::max<std::size_t>(n, DoublingGrowth {}(capacity(), n));
+        remap(kDataOffset + n * sizeof(T));
+        header()->cap = n;
+    }
+
+    void resize(std::size_t n)
+    {
+        checkWritable();
+        reserve(n);
+        if (n > size())
+            std::memset(static_cast<void *>(data() + size()),
+                        0,
+                        (n - size()) * sizeof(T));
+        header()->size = n;
+    }
+
+    void clear()
+    {
+        checkWritable();
+        header()->size = 0;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        checkWritable();
+        std::size_t n = size();
+        if (n == capacity()) [[unlikely]]
+            reserve(n + 1);
+
+        T *p = ::new (static_cast<void *>(data() + n)) T(std::forward<Args>(args)...);
+        header()->size = n + 1;
+        return *p;
+    }
+
+    void pop_back()
+    {
+        checkWritable();
+        header()->size -= 1;
+    }
+
+    T &operator[](std::size_t i) noexcept { return data()[i]; }
+
+    const T &operator[](std::size_t i) const noexcept { return data()[i]; }
+
+    T &at(std::size_t i)
+    {
+        if (i >= size()) [[unlikely]]
+            throw std::out_of_range("MappedVector at function");
+        return data()[i];
+    }
+
+    const T &at(std::size_t i) const
+    {
+        if (i >= size()) [[unlikely]]
+            throw std::out_of_range("MappedVector at function");
+        return data()[i];
+    }
+
+    T &front() noexcept { return data()[0]; }
+
+    const T &front() const noexcept { return data()[0]; }
+
+    T &back() noexcept { return data()[size() - 1]; }
+
+    const T &back() const noexcept { return data()[size() - 1]; }
+
+    T *data() noexcept
+    {
+        return mBase ? reinterpret_cast<T *>(mBase + kDataOffset) : nullptr;
+    }
+
+    const T *data() const noexcept
+    {
+        return mBase ? reinterpret_cast<const T *>(mBase + kDataOffset) : nullptr;
+    }
+
+    T *begin() noexcept { return data(); }
+
+    T *end() noexcept { return data() + size(); }
+
+    const T *begin() const noexcept { return data(); }
+
+    const T *end() const noexcept { return data() + size(); }
+
+    const T *cbegin() const noexcept { return data(); }
+
+    const T *cend() const noexcept { return data() + size(); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return std::make_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return std::make_reverse_iterator(begin());
+    }
+
+  private:
+    Header *header() noexcept { return reinterpret_cast<Header *>(mBase); }
+
+    const Header *header() const noexcept
+    {
+        return reinterpret_cast<const Header *>(mBase);
+    }
+
+    void checkWritable() const
+    {
+        if (mMode == MapMode::ReadOnly) [[unlikely]]
+            throw std::logic_error("MappedVector: mutating a read-only mapping");
+    }
+
+    [[noreturn]] void fail(const std::string &what)
+    {
+        close();
+        throw std::runtime_error(what);
+    }
+
+    void map(std::size_t bytes)
+    {
+        int prot  = mMode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        int flags = mMode == MapMode::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+        void *p   = ::mmap(nullptr, bytes, prot, flags, mFd, 0);
+        if (p == MAP_FAILED)
+            fail("MappedVector: mmap failed");
+        mBase   = static_cast<std::byte *>(p);
+        mMapped = bytes;
+    }
+
+    /// Grow the mapping to bytes. ReadWrite extends the file; CopyOnWrite cannot touch
+    /// the file, so it moves the data into a private anonymous mapping instead.
+    void remap(std::size_t bytes)
+    {
+        void *p;
+        if (mMode == MapMode::ReadWrite)
+        {
+            if (::ftruncate(mFd, static_cast<off_t>(bytes)) != 0)
+                throw std::system_error(errno,
+                                        std::generic_category(),
+                                        "MappedVector: cannot grow the file");
+#ifdef __linux__
+            p = ::mremap(mBase, mMapped, bytes, MREMAP_MAYMOVE);
+#else
+            // the old mapping stays until the new one exists
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+            if (p != MAP_FAILED)
+                ::munmap(mBase, mMapped);
+#endif
+        }
+        else if (mPrivateCopy)
+        {
+#ifdef __linux__
+            p = ::mremap(mBase, mMapped, bytes, MREMAP_MAYMOVE);
+#else
+            p = ::mmap(nullptr,
+                       bytes,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1,
+                       0);
+            if (p != MAP_FAILED)
+            {
+                std::memcpy(p, mBase, mMapped);
+                ::munmap(mBase, mMapped);
+            }
+#endif
+        }
+        else
+        {
+            p = ::mmap(nullptr,
+                       bytes,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1,
+                       0);
+            if (p != MAP_FAILED)
+            {
+                std::memcpy(p, mBase, kDataOffset + size() * sizeof(T));
+                ::munmap(mBase, mMapped);
+                mPrivateCopy = true;
+            }
+        }
+
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        mBase   = static_cast<std::byte *>(p);
+        mMapped = bytes;
+    }
+
+    void close() noexcept
+    {
+        if (mBase)
+            ::munmap(mBase, mMapped);
+        if (mFd >= 0)
+            ::close(mFd);
+        mBase = nullptr;
+        mFd   = -1;
+    }
+};
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "UniquePtr.hpp"
+
+/// Source of raw memory behind PolymorphicAllocator. Resources are not copyable; every
+/// container allocating from one just holds a pointer to it.
+struct MemoryResource
+{
+    MemoryResource() = default;
+
+    MemoryResource(const MemoryResource &)            = delete;
+    MemoryResource &operator=(const MemoryResource &) = delete;
+
+    virtual ~MemoryResource() = default;
+
+    void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t))
+    {
+        return doAllocate(bytes, align);
+    }
+
+    void deallocate(void *p,
+                    std::size_t bytes,
+                    std::size_t align = alignof(std::max_align_t)) noexcept
+    {
+        doDeallocate(p, bytes, align);
+    }
+
+  protected:
+    virtual void *doAllocate(std::size_t bytes, std::size_t align) = 0;
+
+    virtual void doDeallocate(void *p, std::size_t bytes, std::size_t align) noexcept = 0;
+};
+
+/// Plain operator new / operator delete.
+struct NewDeleteResource final : MemoryResource
+{
+  protected:
+    void *doAllocate(std::size_t bytes, std::size_t align) override
+    {
+        return ::operator new(bytes, std::align_val_t(align));
+    }
+
+    void doDeallocate(void *p, std::size_t, std::size_t align) noexcept override
+    {
+        ::operator delete(p, std::align_val_t(align));
+    }
+};
+
+inline MemoryResource *newDeleteResource() noexcept
+{
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+/// Bump allocator: carves blocks off geometrically growing chunks and never reuses
+/// them. deallocate is a no-op; release() (or the destructor) hands every chunk back
+/// to the upstream resource at once. An optional caller buffer, e.g. on the stack, is
+/// used before the first chunk. Not thread-safe.
+struct MonotonicArena final : MemoryResource
+{
+    static constexpr std::size_t kFirstChunk = 4096;
+
+    explicit MonotonicArena(MemoryResource *upstream = newDeleteResource()) noexcept
+        : mUpstream(upstream)
+    { }
+
+    MonotonicArena(void *buffer,
+                   std::size_t size,
+                   MemoryResource *upstream = newDeleteResource()) noexcept
+        : mUpstream(upstream),
+          mBuffer(static_cast<std::byte *>(buffer)),
+          mBufferSize(size),
+          mCur(mBuffer),
+          mEnd(mBuffer + size),
+          mNextChunk(std::max(kFirstChunk, std::bit_ceil(size)))
+    { }
+
+    ~MonotonicArena() noexcept override { release(); }
+
+    /// Free every chunk and start over from the caller buffer, if any.
+    void release() noexcept
+    {
+        while (mChunks)
+        {
+            Chunk *prev = mChunks->prev;
+            mUpstream->deallocate(mChunks, mChunks->size, alignof(Chunk));
+            mChunks = prev;
+        }
+        mCur       = mBuffer;
+        mEnd       = mBuffer + mBufferSize;
+        mNextChunk = std::max(kFirstChunk, std::bit_ceil(mBufferSize));
+    }
+
+    MemoryResource *upstream() const noexcept { return mUpstream; }
+
+  protected:
+    void *doAllocate(std::size_t bytes, std::size_t align) override
+    {
+        // even zero bytes must come back as a real pointer, which an arena with no
+        // chunk yet would not have
+        bytes        = std::max<std::size_t>(bytes, 1);
+        std::byte *p = alignUp(mCur, align);
+        if (p > mEnd || static_cast<std::size_t>(mEnd - p) < bytes) [[unlikely]]
+        {
+            newChunk(bytes + align);
+            p = alignUp(mCur, align);
+        }
+        mCur = p + bytes;
+        return p;
+    }
+
+    void doDeallocate(void *, std::size_t, std::size_t) noexcept override { }
+
+  private:
+    struct alignas(std::max_align_t) Chunk
+    {
+        Chunk *prev;
+        std::size_t size;
+    };
+
+    static std::byte *alignUp(std::byte *p, std::size_t align) noexcept
+    {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        return p + (-addr & (align - 1));   // align is a power of two
+    }
+
+    void newChunk(std::size_t minBytes)
+    {
+        std::size_t size = std::max(mNextChunk, minBytes + sizeof(Chunk));
+        void *raw        = mUpstream->allocate(size, alignof(Chunk));
+        auto *chunk      = static_cast<Chunk *>(raw);
+        chunk->prev      = mChunks;
+        chunk->size      = size;
+        mChunks          = chunk;
+        mCur             = reinterpret_cast<std::byte *>(chunk + 1);
+        mEnd             = reinterpret_cast<std::byte *>(chunk) + size;
+        mNextChunk       = size * 2;
+    }
+
+    MemoryResource *mUpstream;
+    std::byte *mBuffer      = nullptr;
+    std::size_t mBufferSize = 0;
+    std::byte *mCur         = nullptr;
+    std::byte *mEnd         = nullptr;
+    std::size_t mNextChunk  = kFirstChunk;
+    Chunk *mChunks          = nullptr;
+};
+
+/// Segregated free lists for small blocks. Requests up to kMaxBlock bytes are rounded
+/// up to a power-of-two size class and served from 64KB slabs; a freed block goes back
+/// onto its class's list for reuse. Larger or over-aligned requests go to upstream.
+/// Not thread-safe; see ThreadCachingResource for a concurrent front end.
+struct PoolResource final : MemoryResource
+{
+    static constexpr std::size_t kMinBlock  = 8;
+    static constexpr std::size_t kMaxBlock  = 1024;
+    static constexpr std::size_t kClasses   = 8;   // 8, 16, ..., 1024
+    static constexpr std::size_t kSlabBytes = 64 * 1024;
+    static constexpr std::size_t kMaxAlign  = 64;
+
+    explicit PoolResource(MemoryResource *upstream = newDeleteResource()) noexcept
+        : mUpstream(upstream)
+    { }
+
+    ~PoolResource() noexcept override { release(); }
+
+    /// Size class serving (bytes, align), or kClasses if upstream serves it directly.
+    static constexpr std::size_t classOf(std::size_t bytes, std::size_t align) noexcept
+    {
+        std::size_t need = std::max({bytes, align, kMinBlock});
+        if (need > kMaxBlock || align > kMaxAlign)
+            return kClasses;
+        return std::bit_width(need - 1) - std::bit_width(kMinBlock - 1);
+    }
+
+    static constexpr std::size_t classSize(std::size_t cls) noexcept
+    {
+        return kMinBlock << cls;
+    }
+
+    /// Return every slab to upstream, including blocks still handed out.
+    void release() noexcept
+    {
+        while (mSlabs)
+        {
+            Slab *prev = mSlabs->prev;
+            mUpstream->deallocate(mSlabs, kSlabBytes, alignof(Slab));
+            mSlabs = prev;
+        }
+        std::fill(std::begin(mFree), std::end(mFree), nullptr);
+    }
+
+    MemoryResource *upstream() const noexcept { return mUpstream; }
+
+  protected:
+    void *doAllocate(std::size_t bytes, std::size_t align) override
+    {
+        std::size_t cls = classOf(bytes, align);
+        if (cls == kClasses) [[unlikely]]
+            return mUpstream->allocate(bytes, align);
+
+        if (!mFree[cls]) [[unlikely]]
+            refill(cls);
+        FreeBlock *block = mFree[cls];
+        mFree[cls]       = block->next;
+        return block;
+    }
+
+    void doDeallocate(void *p, std::size_t bytes, std::size_t align) noexcept override
+    {
+        std::size_t cls = classOf(bytes, align);
+        if (cls == kClasses) [[unlikely]]
+            return mUpstream->deallocate(p, bytes, align);
+
+        auto *block = static_cast<FreeBlock *>(p);
+        block->next = mFree[cls];
+        mFree[cls]  = block;
+    }
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct alignas(kMaxAlign) Slab
+    {
+        Slab *prev;
+    };
+
+    /// Thread a fresh slab onto the free list of class cls.
+    void refill(std::size_t cls)
+    {
+        auto *slab = static_cast<Slab *>(mUpstream->allocate(kSlabBytes, alignof(Slab)));
+        slab->prev = mSlabs;
+        mSlabs     = slab;
+
+        std::size_t size  = classSize(cls);
+        std::size_t count = (kSlabBytes - sizeof(Slab)) / size;
+        std::byte *first  = reinterpret_cast<std::byte *>(slab + 1);
+        FreeBlock *head   = mFree[cls];
+        for (std::size_t i = count; i-- != 0;)
+        {
+            auto *block = reinterpret_cast<FreeBlock *>(first + i * size);
+            block->next = head;
+            head        = block;
+        }
+        mFree[cls] = head;
+    }
+
+    friend struct ThreadCachingResource;
+
+    MemoryResource *mUpstream;
+    Slab *mSlabs               = nullptr;
+    FreeBlock *mFree[kClasses] = {};
+};
+
+/// Thread-safe PoolResource. Each thread keeps a short free list per size class, so the
+/// common allocate/deallocate pair touches no lock and no shared cache line; the shared
+/// pool is locked only to refill or drain a thread's list in batches of kBatch.
+///
+/// A thread caches blocks for at most kCachedResources live resources at a time, other
+/// ones go straight to the locked pool. Blocks cached by a thread that exits stay
+/// reserved until the resource itself is destroyed.
+struct ThreadCachingResource final : MemoryResource
+{
+    static constexpr std::size_t kBatch           = 32;
+    static constexpr std::size_t kCacheDepth      = 2 * kBatch;
+    static constexpr std::size_t kCachedResources = 4;
+
+    explicit ThreadCachingResource(MemoryResource *upstream = newDeleteResource())
+        : mPool(upstream), mAlive(std::make_shared<bool>(true))
+    { }
+
+    ~ThreadCachingResource() noexcept override = default;
+
+  protected:
+    void *doAllocate(std::size_t bytes, std::size_t align) override
+    {
+        std::size_t cls = PoolResource::classOf(bytes, align);
+        ThreadCache *cache;
+        if (cls == PoolResource::kClasses || !(cache = cacheFor())) [[unlikely]]
+        {
+            std::lock_guard lock(mMutex);
+            return mPool.allocate(bytes, align);
+        }
+
+        if (!cache->heads[cls]) [[unlikely]]
+        {
+            std::lock_guard lock(mMutex);
+            for (std::size_t i = 0; i != kBatch; i++)
+                push(*cache, cls, mPool.allocate(bytes, align));
+        }
+        return pop(*cache, cls);
+    }
+
+    void doDeallocate(void *p, std::size_t bytes, std::size_t align) noexcept override
+    {
+        std::size_t cls = PoolResource::classOf(bytes, align);
+        ThreadCache *cache;
+        if (cls == PoolResource::kClasses || !(cache = cacheFor())) [[unlikely]]
+        {
+            std::lock_guard lock(mMutex);
+            return mPool.deallocate(p, bytes, align);
+        }
+
+        push(*cache, cls, p);
+        if (cache->counts[cls] > kCacheDepth) [[unlikely]]
+        {
+            std::lock_guard lock(mMutex);
+            for (std::size_t i = 0; i != kBatch; i++)
+                mPool.deallocate(pop(*cache, cls), bytes, align);
+        }
+    }
+
+  private:
+    using FreeBlock = PoolResource::FreeBlock;
+
+    struct ThreadCache
+    {
+        const ThreadCachingResource *owner = nullptr;
+        std::uint64_t id                   = 0;
+        std::weak_ptr<bool> alive;
+        FreeBlock *heads[PoolResource::kClasses]     = {};
+        std::uint32_t counts[PoolResource::kClasses] = {};
+    };
+
+    static void push(ThreadCache &cache, std::size_t cls, void *p) noexcept
+    {
+        auto *block      = static_cast<FreeBlock *>(p);
+        block->next      = cache.heads[cls];
+        cache.heads[cls] = block;
+        cache.counts[cls] += 1;
+    }
+
+    static void *pop(ThreadCache &cache, std::size_t cls) noexcept
+    {
+        FreeBlock *block = cache.heads[cls];
+        cache.heads[cls] = block->next;
+        cache.counts[cls] -= 1;
+        return block;
+    }
+
+    static std::uint64_t nextId() noexcept
+    {
+        static std::atomic<std::uint64_t> counter {0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /// This thread's cache for this resource, claiming a slot on first use. The id
+    /// tells a new resource apart from a destroyed one at the same address.
+    ThreadCache *cacheFor() noexcept
+    {
+        thread_local ThreadCache caches[kCachedResources];
+        for (ThreadCache &cache: caches)
+            if (cache.owner == this && cache.id == mId) [[likely]]
+                return &cache;
+
+        for (ThreadCache &cache: caches)
+        {
+            if (cache.owner && !cache.alive.expired())
+                continue;
+            // blocks of a destroyed resource were freed along with its pool
+            cache       = ThreadCache {};
+            cache.owner = this;
+            cache.id    = mId;
+            cache.alive = mAlive;
+            return &cache;
+        }
+        return nullptr;
+    }
+
+    std::mutex mMutex;
+    PoolResource mPool;
+    std::uint64_t mId = nextId();
+    std::shared_ptr<bool> mAlive;
+};
+
+/// Allocator adapter over a MemoryResource. It converts to any other value type, so
+/// containers that rebind (List's nodes, for one) keep allocating from the same
+/// resource. Default-constructed, it uses newDeleteResource().
+template<typename T>
+struct PolymorphicAllocator
+{
+    using value_type = T;
+
+    PolymorphicAllocator() noexcept : mResource(newDeleteResource()) { }
+
+    PolymorphicAllocator(MemoryResource *resource) noexcept : mResource(resource) { }
+
+    template<typename U>
+    PolymorphicAllocator(const PolymorphicAllocator<U> &that) noexcept
+        : mResource(that.resource())
+    { }
+
+    T *allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) [[unlikely]]
+            throw std::bad_array_new_length();
+        return static_cast<T *>(mResource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        mResource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    MemoryResource *resource() const noexcept { return mResource; }
+
+    template<typename U>
+    bool operator==(const PolymorphicAllocator<U> &that) const noexcept
+    {
+        return mResource == that.resource();
+    }
+
+  private:
+    MemoryResource *mResource;
+};
+
+/// Deleter for objects living in a MonotonicArena: runs the destructor only, the
+/// memory comes back when the arena is released.
+template<typename T>
+struct ArenaDeleter
+{
+    void operator()(T *p) const { std::destroy_at(p); }
+};
+
+template<typename T, typename... Args>
+UniquePtr<T, ArenaDeleter<T>> makeArenaUnique(MonotonicArena &arena, Args &&...args)
+{
+    void *p = arena.allocate(sizeof(T), alignof(T));
+    return UniquePtr<T, ArenaDeleter<T>>(::new (p) T(std::forward<Args>(args)...));
+}
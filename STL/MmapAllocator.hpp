@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// Allocator for huge buffers of trivially relocatable data. Blocks of at least
+/// Threshold bytes are anonymous mappings, which can be grown in place or remapped
+/// without copying (mremap on Linux); smaller blocks come from std::allocator.
+///
+/// Beyond allocate/deallocate it offers the two extension points Vector looks for:
+///   bool try_expand(T *p, size_t oldN, size_t newN)  grow without moving, or fail
+///   T *reallocate(T *p, size_t oldN, size_t newN)    resize, moving the bytes if needed
+template<typename T, std::size_t Threshold = 1024 * 1024>
+struct MmapAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = MmapAllocator<U, Threshold>;
+    };
+
+    MmapAllocator() noexcept = default;
+
+    template<typename U>
+    MmapAllocator(const MmapAllocator<U, Threshold> &) noexcept
+    { }
+
+    T *allocate(std::size_t n)
+    {
+        if (!isMapped(n))
+            return std::allocator<T>().allocate(n);
+
+        void *p = ::mmap(nullptr,
+                         mappedBytes(n),
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1,
+                         0);
+        if (p == MAP_FAILED) [[unlikely]]
+            throw std::bad_alloc();
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        if (!isMapped(n))
+            std::allocator<T>().deallocate(p, n);
+        else
+            ::munmap(p, mappedBytes(n));
+    }
+
+    bool try_expand(T *p, std::size_t oldN, std::size_t newN) noexcept
+    {
+        if (!isMapped(oldN) || !isMapped(newN))
+            return false;
+        if (mappedBytes(newN) == mappedBytes(oldN))
+            return true;
+#ifdef __linux__
+        return ::mremap(p, mappedBytes(oldN), mappedBytes(newN), 0) != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+
+    T *reallocate(T *p, std::size_t oldN, std::size_t newN)
+    {
+#ifdef __linux__
+        if (isMapped(oldN) && isMapped(newN))
+        {
+            void *q = ::mremap(p, mappedBytes(oldN), mappedBytes(newN), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) [[unlikely]]
+                throw std::bad_alloc();
+            return static_cast<T *>(q);
+        }
+#endif
+        // crossing the threshold (or no mremap): plain allocate, copy, free
+        T *q = allocate(newN);
+        std::memcpy(static_cast<void *>(q),
+                    static_cast<const void *>(p),
+                    (oldN < newN ? oldN : newN) * sizeof(T));
+        deallocate(p, oldN);
+        return q;
+    }
+
+    bool operator==(const MmapAllocator &) const noexcept { return true; }
+
+  private:
+    static bool isMapped(std::size_t n) noexcept { return n * sizeof(T) >= Threshold; }
+
+    static std::size_t mappedBytes(std::size_t n) noexcept
+    {
+        static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return (n * sizeof(T) + page - 1) / page * page;
+    }
+};
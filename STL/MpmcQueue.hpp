@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// Vyukov's bounded multi-producer multi-consumer queue: a power-of-two ring of cells,
+/// each with a sequence number saying whether it is free for the producer of a given
+/// position or ready for its consumer. One CAS claims a position, so producers and
+/// consumers are lock-free and never allocate after construction. try_push fails
+/// when the ring is full, try_pop when it is empty. T must be nothrow movable.
+template<typename T>
+struct MpmcQueue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T> &&
+                          std::is_nothrow_destructible_v<T>,
+                  "elements are moved in and out of cells by noexcept operations");
+
+    explicit MpmcQueue(std::size_t capacity)
+    {
+        if (capacity < 2)
+            throw std::invalid_argument("MpmcQueue capacity must be at least 2");
+
+        mMask  = std::bit_ceil(capacity) - 1;
+        mCells = std::allocator<Cell>().allocate(mMask + 1);
+        for (std::size_t i = 0; i != mMask + 1; i++)
+            std::construct_at(&mCells[i], i);
+    }
+
+    MpmcQueue(const MpmcQueue &)            = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    ~MpmcQueue() noexcept
+    {
+        std::size_t pos;
+        for (Cell *cell; (cell = claimPop(pos));)
+            releasePop(cell, pos);
+        std::destroy_n(mCells, mMask + 1);
+        std::allocator<Cell>().deallocate(mCells, mMask + 1);
+    }
+
+    std::size_t capacity() const noexcept { return mMask + 1; }
+
+    template<typename... Args>
+    bool try_emplace(Args &&...args)
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, Args &&...>)
+        {
+            return claimPush([&](T *slot) noexcept {
+                std::construct_at(slot, std::forward<Args>(args)...);
+            });
+        }
+        else
+        {
+            // a claimed position must be filled, or its consumer would wait forever:
+            // build the element first, then move it in without throwing
+            T value(std::forward<Args>(args)...);
+            return claimPush([&](T *slot) noexcept {
+                std::construct_at(slot, std::move(value));
+            });
+        }
+    }
+
+    bool try_push(const T &value) { return try_emplace(value); }
+
+    bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+    bool try_pop(T &out)
+    {
+        std::size_t pos;
+        Cell *cell = claimPop(pos);
+        if (!cell)
+            return false;
+
+        struct Release
+        {
+            MpmcQueue *queue;
+            Cell *cell;
+            std::size_t pos;
+
+            ~Release() { queue->releasePop(cell, pos); }
+        } guard {this, cell, pos};
+
+        out = std::move(cell->value);
+        return true;
+    }
+
+    /// Pop up to max elements, passing each to fn(T &&); returns how many.
+    template<typename Fn>
+    std::size_t consume(Fn &&fn, std::size_t max = static_cast<std::size_t>(-1))
+    {
+        std::size_t n = 0, pos;
+        for (Cell *cell; n != max && (cell = claimPop(pos)); n++)
+        {
+            struct Release
+            {
+                MpmcQueue *queue;
+                Cell *cell;
+                std::size_t pos;
+
+                ~Release() { queue->releasePop(cell, pos); }
+            } guard {this, cell, pos};
+
+            fn(std::move(cell->value));
+        }
+        return n;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<std::size_t> seq;
+
+        union
+        {
+            T value;
+        };
+
+        explicit Cell(std::size_t i) noexcept : seq(i) { }
+
+        ~Cell() { }
+    };
+
+    template<typename Construct>
+    bool claimPush(Construct &&construct) noexcept
+    {
+        std::size_t pos = mEnqueue.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell *cell         = &mCells[pos & mMask];
+            std::size_t seq    = cell->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+            if (dif == 0)
+            {
+                if (mEnqueue.compare_exchange_weak(pos,
+                                                   pos + 1,
+                                                   std::memory_order_relaxed))
+                {
+                    construct(&cell->value);
+                    cell->seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (dif < 0)
+            {
+                return false;   // full
+            }
+            else
+            {
+                pos = mEnqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Cell *claimPop(std::size_t &pos) noexcept
+    {
+        pos = mDequeue.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell *cell         = &mCells[pos & mMask];
+            std::size_t seq    = cell->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (dif == 0)
+            {
+                if (mDequeue.compare_exchange_weak(pos,
+                                                   pos + 1,
+                                                   std::memory_order_relaxed))
+                    return cell;
+            }
+            else if (dif < 0)
+            {
+                return nullptr;   // empty
+            }
+            else
+            {
+                pos = mDequeue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Free the cell claimed at pos for the producer one lap later.
+    void releasePop(Cell *cell, std::size_t pos) noexcept
+    {
+        std::destroy_at(&cell->value);
+        cell->seq.store(pos + mMask + 1, std::memory_order_release);
+    }
+
+    Cell *mCells;
+    std::size_t mMask;
+    alignas(64) std::atomic<std::size_t> mEnqueue {0};
+    alignas(64) std::atomic<std::size_t> mDequeue {0};
+};
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// Link embedded in objects queued on an IntrusiveMpscQueue: a ListBaseNode-style
+/// next pointer, atomic because producers publish through it.
+struct MpscHook
+{
+    std::atomic<MpscHook *> next {nullptr};
+};
+
+/// Vyukov's intrusive multi-producer single-consumer queue. push is wait-free: one
+/// exchange on the head plus one store. pop is lock-free for the single consumer, but
+/// may report empty while a producer sits between those two steps; the element shows
+/// up once that producer resumes. Objects are linked through their MpscHook member
+/// Hook and are never copied or owned by the queue.
+template<typename T, auto Hook>
+struct IntrusiveMpscQueue
+{
+    IntrusiveMpscQueue() noexcept : mHead(&mStub), mTail(&mStub) { }
+
+    IntrusiveMpscQueue(const IntrusiveMpscQueue &)            = delete;
+    IntrusiveMpscQueue &operator=(const IntrusiveMpscQueue &) = delete;
+
+    /// Any thread.
+    void push(T &value) noexcept { pushHook(&(value.*Hook)); }
+
+    /// Consumer thread only. Returns nullptr if nothing is ready.
+    T *pop() noexcept
+    {
+        MpscHook *tail = mTail;
+        MpscHook *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &mStub)
+        {
+            if (!next)
+                return nullptr;
+            mTail = next;
+            tail  = next;
+            next  = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            mTail = next;
+            return toObject(tail);
+        }
+
+        // tail is the last linked node: unless a producer is mid-push, put the stub
+        // behind it so tail can be handed out
+        if (tail != mHead.load(std::memory_order_acquire))
+            return nullptr;
+        pushHook(&mStub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            mTail = next;
+            return toObject(tail);
+        }
+        return nullptr;
+    }
+
+    /// Consumer thread only. Pop up to max objects into out; returns how many.
+    std::size_t pop_bulk(T **out, std::size_t max) noexcept
+    {
+        std::size_t n = 0;
+        for (T *value; n != max && (value = pop()); n++)
+            out[n] = value;
+        return n;
+    }
+
+    /// Consumer thread only; a snapshot that may be stale by the time it returns. Only
+    /// the stub with nothing behind it is empty: any other tail is an object to pop.
+    bool empty() const noexcept
+    {
+        return mTail == &mStub && mStub.next.load(std::memory_order_acquire) == nullptr;
+    }
+
+  private:
+    static T *toObject(MpscHook *hook) noexcept
+    {
+        alignas(T) unsigned char probe[sizeof(T)];
+        auto *obj          = reinterpret_cast<T *>(probe);
+        std::ptrdiff_t off = reinterpret_cast<unsigned char *>(&(obj->*Hook)) - probe;
+        return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(hook) - off);
+    }
+
+    void pushHook(MpscHook *hook) noexcept
+    {
+        hook->next.store(nullptr, std::memory_order_relaxed);
+        MpscHook *prev = mHead.exchange(hook, std::memory_order_acq_rel);
+        prev->next.store(hook, std::memory_order_release);
+    }
+
+    alignas(64) std::atomic<MpscHook *> mHead;   // producers
+    alignas(64) MpscHook *mTail;                 // consumer
+    MpscHook mStub;
+};
+
+/// Value-owning MPSC queue on top of IntrusiveMpscQueue. Nodes are recycled: the
+/// consumer pushes spent nodes onto a lock-free free list, and a producer that runs out
+/// takes that whole list at once into a cache private to its thread, so a queue in
+/// steady state never allocates. Taking the whole list with one exchange avoids the
+/// ABA problem of popping single nodes.
+template<typename T>
+struct MpscQueue
+{
+  private:
+    struct Node
+    {
+        MpscHook hook;
+
+        union
+        {
+            T value;
+            Node *freeNext;   // while the node sits on a free list
+        };
+
+        Node() noexcept { }
+
+        ~Node() { }
+    };
+
+    using Queue = IntrusiveMpscQueue<Node, &Node::hook>;
+
+    /// Spare nodes owned by one thread; they serve every MpscQueue<T> the thread
+    /// produces into and are freed when the thread exits.
+    struct NodeCache
+    {
+        Node *head = nullptr;
+
+        ~NodeCache() { freeChain(head); }
+    };
+
+    static NodeCache &threadCache() noexcept
+    {
+        thread_local NodeCache cache;
+        return cache;
+    }
+
+    static void freeChain(Node *node) noexcept
+    {
+        while (node)
+        {
+            Node *next = node->freeNext;
+            delete node;
+            node = next;
+        }
+    }
+
+    Node *acquireNode()
+    {
+        NodeCache &cache = threadCache();
+        if (!cache.head) [[unlikely]]
+        {
+            cache.head = mFree.exchange(nullptr, std::memory_order_acquire);
+            if (!cache.head)
+                return new Node;
+        }
+        Node *node = cache.head;
+        cache.head = node->freeNext;
+        return node;
+    }
+
+    /// Hand the chain first..last back to producers with one CAS.
+    void recycle(Node *first, Node *last) noexcept
+    {
+        Node *head = mFree.load(std::memory_order_relaxed);
+        do
+            last->freeNext = head;
+        while (!mFree.compare_exchange_weak(head,
+                                            first,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+    }
+
+    Queue mQueue;
+    alignas(64) std::atomic<Node *> mFree {nullptr};
+
+  public:
+    MpscQueue() noexcept = default;
+
+    MpscQueue(const MpscQueue &)            = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /// No producer may still be pushing.
+    ~MpscQueue() noexcept
+    {
+        while (Node *node = mQueue.pop())
+        {
+            std::destroy_at(&node->value);
+            delete node;
+        }
+        freeChain(mFree.load(std::memory_order_acquire));
+    }
+
+    /// Any thread. Wait-free unless a fresh node has to be allocated.
+    template<typename... Args>
+    void emplace(Args &&...args)
+    {
+        Node *node = acquireNode();
+        try
+        {
+            std::construct_at(&node->value, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeCache &cache = threadCache();
+            node->freeNext   = cache.head;
+            cache.head       = node;
+            throw;
+        }
+        mQueue.push(*node);
+    }
+
+    void push(const T &value) { emplace(value); }
+
+    void push(T &&value) { emplace(std::move(value)); }
+
+    /// Consumer thread only.
+    bool try_pop(T &out)
+    {
+        Node *node = mQueue.pop();
+        if (!node)
+            return false;
+
+        struct Recycle
+        {
+            MpscQueue *queue;
+            Node *node;
+
+            ~Recycle()
+            {
+                std::destroy_at(&node->value);
+                queue->recycle(node, node);
+            }
+        } guard {this, node};
+
+        out = std::move(node->value);
+        return true;
+    }
+
+    /// Consumer thread only. Call fn(T &&) for up to max ready elements and recycle
+    /// their nodes in one batch; returns how many were consumed.
+    template<typename Fn>
+    std::size_t consume(Fn &&fn, std::size_t max = static_cast<std::size_t>(-1))
+    {
+        struct Batch
+        {
+            MpscQueue *queue;
+            Node *first = nullptr;
+            Node *last  = nullptr;
+
+            void add(Node *node) noexcept
+            {
+                std::destroy_at(&node->value);
+                node->freeNext = first;
+                first          = node;
+                if (!last)
+                    last = node;
+            }
+
+            ~Batch()
+            {
+                if (first)
+                    queue->recycle(first, last);
+            }
+        } batch {this};
+
+        std::size_t n = 0;
+        for (Node *node; n != max && (node = mQueue.pop()); n++)
+        {
+            try
+            {
+                fn(std::move(node->value));
+            }
+            catch (...)
+            {
+                batch.add(node);
+                throw;
+            }
+            batch.add(node);
+        }
+        return n;
+    }
+
+    /// Consumer thread only; may miss an element a producer is still linking.
+    bool empty() const noexcept { return mQueue.empty(); }
+};
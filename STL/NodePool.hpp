@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// Fixed-size block allocator for linked containers. Blocks are carved from 64KB slabs
+/// and recycled through a free list, so steady insert/erase churn never reaches malloc.
+/// Slabs are aligned to their size, which finds a block's slab with one mask and lets
+/// shrink() return slabs whose blocks are all free. Not thread-safe.
+struct NodePool
+{
+    static constexpr std::size_t kSlabBytes = 64 * 1024;
+
+    explicit NodePool(std::size_t blockSize,
+                      std::size_t align = alignof(std::max_align_t))
+        : mAlign(std::max(align, alignof(FreeBlock))),
+          mBlockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)), mAlign)),
+          mHeaderSize(roundUp(sizeof(Slab), mAlign))
+    {
+        if (mHeaderSize + mBlockSize > kSlabBytes) [[unlikely]]
+            throw std::bad_alloc();
+    }
+
+    NodePool(const NodePool &)            = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    ~NodePool() noexcept
+    {
+        while (mSlabs)
+        {
+            Slab *next = mSlabs->next;
+            freeSlab(mSlabs);
+            mSlabs = next;
+        }
+    }
+
+    std::size_t blockSize() const noexcept { return mBlockSize; }
+
+    std::size_t alignment() const noexcept { return mAlign; }
+
+    std::size_t slabCount() const noexcept { return mSlabCount; }
+
+    std::size_t liveBlocks() const noexcept { return mLive; }
+
+    void *allocate()
+    {
+        std::byte *p;
+        if (mFree)
+        {
+            p     = reinterpret_cast<std::byte *>(mFree);
+            mFree = mFree->next;
+        }
+        else
+        {
+            if (mBump == mBumpEnd) [[unlikely]]
+                newSlab();
+            p = mBump;
+            mBump += mBlockSize;
+        }
+        slabOf(p)->live += 1;
+        mLive += 1;
+        return p;
+    }
+
+    void deallocate(void *p) noexcept
+    {
+        slabOf(p)->live -= 1;
+        mLive -= 1;
+        auto *block = static_cast<FreeBlock *>(p);
+        block->next = mFree;
+        mFree       = block;
+    }
+
+    /// Return every slab without live blocks to the system; the free list is rebuilt
+    /// without their blocks. Returns the number of bytes released.
+    std::size_t shrink() noexcept
+    {
+        FreeBlock **link = &mFree;
+        while (*link)
+        {
+            if (slabOf(*link)->live == 0)
+                *link = (*link)->next;
+            else
+                link = &(*link)->next;
+        }
+
+        std::size_t released = 0;
+        for (Slab *slab = mSlabs; slab;)
+        {
+            Slab *next = slab->next;
+            if (slab->live == 0)
+            {
+                if (mBump && slab == slabOf(mBump - 1))
+                    mBump = mBumpEnd = nullptr;
+                unlink(slab);
+                freeSlab(slab);
+                released += kSlabBytes;
+            }
+            slab = next;
+        }
+        return released;
+    }
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct Slab
+    {
+        Slab *prev;
+        Slab *next;
+        std::size_t live;
+    };
+
+    static constexpr std::size_t roundUp(std::size_t n, std::size_t align) noexcept
+    {
+        return (n + align - 1) / align * align;
+    }
+
+    static Slab *slabOf(const void *p) noexcept
+    {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<Slab *>(addr & ~(kSlabBytes - 1));
+    }
+
+    void newSlab()
+    {
+        void *raw  = ::operator new(kSlabBytes, std::align_val_t(kSlabBytes));
+        auto *slab = ::new (raw) Slab {nullptr, mSlabs, 0};
+        if (mSlabs)
+            mSlabs->prev = slab;
+        mSlabs = slab;
+        mSlabCount += 1;
+
+        // carve lazily, so a fresh slab is touched only as far as it is used
+        std::byte *base = static_cast<std::byte *>(raw);
+        mBump           = base + mHeaderSize;
+        mBumpEnd        = mBump + (kSlabBytes - mHeaderSize) / mBlockSize * mBlockSize;
+    }
+
+    void unlink(Slab *slab) noexcept
+    {
+        if (slab->prev)
+            slab->prev->next = slab->next;
+        else
+            mSlabs = slab->next;
+        if (slab->next)
+            slab->next->prev = slab->prev;
+    }
+
+    void freeSlab(Slab *slab) noexcept
+    {
+        ::operator delete(static_cast<void *>(slab), std::align_val_t(kSlabBytes));
+        mSlabCount -= 1;
+    }
+
+    std::size_t mAlign;
+    std::size_t mBlockSize;
+    std::size_t mHeaderSize;
+    Slab *mSlabs           = nullptr;
+    FreeBlock *mFree       = nullptr;
+    std::byte *mBump       = nullptr;
+    std::byte *mBumpEnd    = nullptr;
+    std::size_t mSlabCount = 0;
+    std::size_t mLive      = 0;
+};
+
+/// Allocator that serves single-object allocations from a NodePool; arrays and types
+/// that do not fit the pool's blocks go to operator new. A default-constructed
+/// allocator creates its own pool, sized for its value type, on first use; one made
+/// from a shared pool lets several containers recycle each other's nodes.
+///
+/// Containers that rebind must keep the rebound allocator (as List does), since the
+/// pool lives in that copy.
+template<typename T>
+struct NodePoolAllocator
+{
+    using value_type = T;
+    // List allocates nodes one at a time for us rather than in blocks, which the pool
+    // would pass on to operator new
+    using single_node_only = std::true_type;
+
+    NodePoolAllocator() noexcept = default;
+
+    explicit NodePoolAllocator(std::shared_ptr<NodePool> pool) noexcept
+        : mPool(std::move(pool))
+    { }
+
+    template<typename U>
+    NodePoolAllocator(const NodePoolAllocator<U> &that) noexcept : mPool(that.pool())
+    { }
+
+    T *allocate(std::size_t n)
+    {
+        if (n == 1) [[likely]]
+        {
+            if (!mPool) [[unlikely]]
+                mPool = std::make_shared<NodePool>(sizeof(T), alignof(T));
+            if (fits())
+                return static_cast<T *>(mPool->allocate());
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        if (n == 1 && mPool && fits()) [[likely]]
+            mPool->deallocate(p);
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    const std::shared_ptr<NodePool> &pool() const noexcept { return mPool; }
+
+    template<typename U>
+    bool operator==(const NodePoolAllocator<U> &that) const noexcept
+    {
+        return mPool == that.pool();
+    }
+
+  private:
+    bool fits() const noexcept
+    {
+        return sizeof(T) <= mPool->blockSize() && alignof(T) <= mPool->alignment();
+    }
+
+    std::shared_ptr<NodePool> mPool;
+};
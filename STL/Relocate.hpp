@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// A type is trivially relocatable when "move-construct into new storage, then destroy
+/// the source" is equivalent to copying its bytes. Trivially copyable types are by
+/// default; other types (e.g. owning handles like UniquePtr) opt in by specializing.
+template<typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+{ };
+
+template<typename T>
+inline constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+/// Relocate [first, last) into the uninitialized, non-overlapping storage at dest.
+/// The source range is left uninitialized.
+template<typename T>
+void uninitRelocate(T *first, T *last, T *dest) noexcept(
+        isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>)
+{
+    if constexpr (isTriviallyRelocatable<T>)
+    {
+        if (first != last)
+            std::memcpy(static_cast<void *>(dest),
+                        static_cast<const void *>(first),
+                        (last - first) * sizeof(T));
+    }
+    else
+    {
+        for (; first != last; ++first, ++dest)
+        {
+            std::construct_at(dest, std::move_if_noexcept(*first));
+            std::destroy_at(first);
+        }
+    }
+}
+
+/// Shift [first, last) n slots to the right, into storage that may overlap the source.
+/// [last, last + n) must be uninitialized; afterwards [first, first + n) is.
+template<typename T>
+void relocateRight(T *first, T *last, std::size_t n) noexcept(
+        isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>)
+{
+    if constexpr (isTriviallyRelocatable<T>)
+    {
+        if (first != last)
+            std::memmove(static_cast<void *>(first + n),
+                         static_cast<const void *>(first),
+                         (last - first) * sizeof(T));
+    }
+    else
+    {
+        while (last != first)
+        {
+            --last;
+            std::construct_at(last + n, std::move(*last));
+            std::destroy_at(last);
+        }
+    }
+}
+
+/// Shift [first, last) down onto dest (dest < first), into storage that may overlap the
+/// source. [dest, first) must be uninitialized; afterwards the vacated tail is.
+template<typename T>
+void relocateLeft(T *first, T *last, T *dest) noexcept(
+        isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>)
+{
+    if constexpr (isTriviallyRelocatable<T>)
+    {
+        if (first != last)
+            std::memmove(static_cast<void *>(dest),
+                         static_cast<const void *>(first),
+                         (last - first) * sizeof(T));
+    }
+    else
+    {
+        for (; first != last; ++first, ++dest)
+        {
+            std::construct_at(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define _LIBPOWERCXX_SIMD_PACK 1
+#endif
+
+/// Widest vector register the build targets, in bytes: 64 with -mavx512f, 32 with
+/// -mavx, 16 with SSE2 or NEON. Chosen at compile time rather than dispatched like
+/// SimdSearch's kernels, because the loops that use it run over a handful of elements
+/// and must inline into the caller; a target-specific function never can.
+inline constexpr std::size_t kSimdPackBytes =
+#if !defined(_LIBPOWERCXX_SIMD_PACK)
+        0;
+#elif defined(__AVX512F__)
+        64;
+#elif defined(__AVX__)
+        32;
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+        16;
+#else
+        0;
+#endif
+
+/// Element types that go into packs: integers other than bool, float and double.
+template<typename T>
+inline constexpr bool isSimdPackable =
+        (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, float> ||
+        std::is_same_v<T, double>;
+
+#ifdef _LIBPOWERCXX_SIMD_PACK
+/// Bytes / sizeof(T) lanes of T in one register. Arithmetic and comparison operators
+/// work lane by lane, and ?: selects lanes by a comparison mask.
+template<typename T, std::size_t Bytes>
+struct SimdPackType
+{
+    // an alias template would drop the attribute; a member typedef keeps it
+    typedef T type __attribute__((vector_size(Bytes)));
+
+    // the same pack at T's alignment, to load and store through; it aliases T, so,
+    // unlike memcpy, a store does not make the compiler reload unrelated pointers
+    typedef T unaligned __attribute__((vector_size(Bytes), aligned(alignof(T))));
+};
+
+template<typename T, std::size_t Bytes>
+using SimdPack = typename SimdPackType<T, Bytes>::type;
+#else
+template<typename T, std::size_t Bytes>
+struct SimdPack;   // never instantiated: kSimdPackBytes is 0
+#endif
+
+/// Pack width to use for n elements of T: the widest register that n elements fill
+/// at least once, or 0 to stay scalar.
+template<typename T>
+constexpr std::size_t simdPackBytes(std::size_t n) noexcept
+{
+    if constexpr (!isSimdPackable<T>)
+        return 0;
+    std::size_t bytes = kSimdPackBytes;
+    while (bytes >= 16 && bytes > n * sizeof(T))
+        bytes /= 2;
+    return bytes >= 16 ? bytes : 0;
+}
+
+/// Pack width for a loop that stores n elements. Below two 16-byte packs a fixed pack
+/// plus a scalar tail loses to what the compiler does with a plain loop: it vectorizes
+/// across neighbouring Arrays when they sit in a larger loop, which a pack cannot.
+template<typename T>
+constexpr std::size_t simdStoreBytes(std::size_t n) noexcept
+{
+    return n * sizeof(T) >= 32 ? simdPackBytes<T>(n) : 0;
+}
+
+/// V is either T itself or a SimdPack of T; the helpers below take both, so one
+/// generic body serves the vector loop and its scalar tail.
+template<typename V, typename T>
+inline V simdLoad(const T *p) noexcept
+{
+    if constexpr (std::is_same_v<V, T>)
+        return *p;
+    else
+    {
+        using Unaligned = typename SimdPackType<T, sizeof(V)>::unaligned;
+        return *reinterpret_cast<const Unaligned *>(p);
+    }
+}
+
+template<typename V, typename T>
+inline void simdStore(T *p, const V &v) noexcept
+{
+    if constexpr (std::is_same_v<V, T>)
+        *p = v;
+    else
+    {
+        using Unaligned = typename SimdPackType<T, sizeof(V)>::unaligned;
+        *reinterpret_cast<Unaligned *>(p) = v;
+    }
+}
+
+template<typename V, typename T>
+inline V simdBroadcast(const T &value) noexcept
+{
+    if constexpr (std::is_same_v<V, T>)
+        return value;
+    else
+    {
+        V v;
+        for (std::size_t k = 0; k != sizeof(V) / sizeof(T); k++)
+            v[k] = value;
+        return v;
+    }
+}
+
+/// Call fn(V {}, i) over [From, N) in steps of one V: packs of Bytes while whole ones
+/// fit, then half as wide, down to T {} for the last elements. Every bound is a
+/// constant, so the compiler unrolls small N completely.
+template<typename T, std::size_t N, std::size_t Bytes = simdStoreBytes<T>(N),
+         std::size_t From = 0, typename Fn>
+inline void simdForEach(Fn &&fn)
+{
+    if constexpr (Bytes >= 16)
+    {
+        constexpr std::size_t kLanes = Bytes / sizeof(T);
+        constexpr std::size_t kEnd   = From + (N - From) / kLanes * kLanes;
+        for (std::size_t i = From; i != kEnd; i += kLanes)
+            fn(SimdPack<T, Bytes> {}, i);
+        simdForEach<T, N, Bytes / 2, kEnd>(fn);
+    }
+    else
+    {
+        for (std::size_t i = From; i != N; i++)
+            fn(T {}, i);
+    }
+}
+
+template<typename T, std::size_t N, std::size_t Bytes, std::size_t From, typename Load,
+         typename Combine>
+inline T simdReduceFrom(SimdPack<T, Bytes> acc, Load &load, Combine &combine)
+{
+    constexpr std::size_t kLanes = Bytes / sizeof(T);
+    constexpr std::size_t kEnd   = From + (N - From) / kLanes * kLanes;
+    for (std::size_t i = From; i != kEnd; i += kLanes)
+        acc = combine(acc, load(SimdPack<T, Bytes> {}, i));
+
+    if constexpr (Bytes > 16)
+    {
+        using Half = SimdPack<T, Bytes / 2>;
+        Half lo, hi;
+        std::memcpy(&lo, &acc, sizeof(Half));
+        std::memcpy(&hi, reinterpret_cast<const char *>(&acc) + sizeof(Half),
+                    sizeof(Half));
+        return simdReduceFrom<T, N, Bytes / 2, kEnd>(combine(lo, hi), load, combine);
+    }
+    else
+    {
+        T result = acc[0];
+        for (std::size_t k = 1; k != kLanes; k++)
+            result = combine(result, acc[k]);
+        for (std::size_t i = kEnd; i != N; i++)
+            result = combine(result, load(T {}, i));
+        return result;
+    }
+}
+
+/// Fold load(V {}, i) over [0, N) with combine, which must be associative and
+/// commutative: each lane accumulates its own column, the halves of the accumulator
+/// are folded together as the packs narrow, and the tail is folded in last.
+template<typename T, std::size_t N, typename Load, typename Combine>
+inline T simdReduce(Load &&load, Combine &&combine)
+{
+    static_assert(N != 0, "simdReduce needs at least one element");
+    constexpr std::size_t kBytes = simdPackBytes<T>(N);
+    if constexpr (kBytes == 0)
+    {
+        T acc = load(T {}, 0);
+        for (std::size_t i = 1; i != N; i++)
+            acc = combine(acc, load(T {}, i));
+        return acc;
+    }
+    else
+    {
+        using V = SimdPack<T, kBytes>;
+        V acc   = load(V {}, 0);
+        return simdReduceFrom<T, N, kBytes, kBytes / sizeof(T)>(acc, load, combine);
+    }
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+        (defined(__GNUC__) || defined(__clang__))
+    #define _LIBPOWERCXX_SIMD_X86 1
+    #include <immintrin.h>
+#endif
+
+/// Element types the vectorized kernels handle: 1/2/4/8-byte integers, float and
+/// double. Everything else goes through the scalar <algorithm> path.
+template<typename T>
+inline constexpr bool isSimdSearchable =
+        (std::is_integral_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                                   sizeof(T) == 8)) ||
+        std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/// Whether searching for or comparing elements cannot throw: always so in the kernels,
+/// otherwise only if T's own == (or <=>) is noexcept.
+template<typename T>
+inline constexpr bool isNothrowSearchable =
+        isSimdSearchable<T> ||
+        noexcept(std::declval<const T &>() == std::declval<const T &>());
+
+template<typename T>
+inline constexpr bool isNothrowComparable =
+        isSimdSearchable<T> ||
+        noexcept(std::declval<const T &>() <=> std::declval<const T &>());
+
+enum class SimdLevel { Scalar, Sse42, Avx2 };
+
+/// Best instruction set the running CPU supports, detected once.
+inline SimdLevel simdLevel() noexcept
+{
+#ifdef _LIBPOWERCXX_SIMD_X86
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::Avx2;
+        if (__builtin_cpu_supports("sse4.2"))
+            return SimdLevel::Sse42;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+#ifdef _LIBPOWERCXX_SIMD_X86
+
+// Each kernel set compares one register of elements at a time and turns the result
+// into a bitmask with one bit per byte, so a lane of T owns sizeof(T) adjacent bits.
+// Only the three primitives below are vectorized; everything else builds on them.
+
+struct Avx2Kernels
+{
+    static constexpr std::size_t kBytes = 32;
+
+    template<typename T>
+    [[gnu::target("avx2")]] static std::uint32_t eqMask(const T *a, const T *b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm256_movemask_epi8(_mm256_castps_si256(
+                    _mm256_cmp_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b), _CMP_EQ_OQ)));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm256_movemask_epi8(_mm256_castpd_si256(
+                    _mm256_cmp_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b), _CMP_EQ_OQ)));
+        else
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+            if constexpr (sizeof(T) == 1)
+                return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+            else if constexpr (sizeof(T) == 2)
+                return _mm256_movemask_epi8(_mm256_cmpeq_epi16(x, y));
+            else if constexpr (sizeof(T) == 4)
+                return _mm256_movemask_epi8(_mm256_cmpeq_epi32(x, y));
+            else
+                return _mm256_movemask_epi8(_mm256_cmpeq_epi64(x, y));
+        }
+    }
+
+    template<typename T>
+    [[gnu::target("avx2")]] static std::size_t find(const T *p, std::size_t n, T value)
+    {
+        constexpr std::size_t lanes = kBytes / sizeof(T);
+        T splat[lanes];
+        std::fill_n(splat, lanes, value);
+
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            if (std::uint32_t mask = eqMask(p + i, splat))
+                return i + std::countr_zero(mask) / sizeof(T);
+        }
+        for (; i != n; i++)
+            if (p[i] == value)
+                return i;
+        return n;
+    }
+
+    template<typename T>
+    [[gnu::target("avx2")]] static std::size_t count(const T *p, std::size_t n, T value)
+    {
+        constexpr std::size_t lanes = kBytes / sizeof(T);
+        T splat[lanes];
+        std::fill_n(splat, lanes, value);
+
+        std::size_t bits = 0, i = 0;
+        for (; i + lanes <= n; i += lanes)
+            bits += std::popcount(eqMask(p + i, splat));
+
+        std::size_t total = bits / sizeof(T);
+        for (; i != n; i++)
+            total += p[i] == value;
+        return total;
+    }
+
+    template<typename T>
+    [[gnu::target("avx2")]] static std::size_t mismatch(const T *a,
+                                                        const T *b,
+                                                        std::size_t n)
+    {
+        constexpr std::size_t lanes = kBytes / sizeof(T);
+
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            if (std::uint32_t mask = ~eqMask(a + i, b + i))
+                return i + std::countr_zero(mask) / sizeof(T);
+        }
+        for (; i != n; i++)
+            if (!(a[i] == b[i]))
+                return i;
+        return n;
+    }
+};
+
+struct Sse42Kernels
+{
+    static constexpr std::size_t kBytes = 16;
+
+    template<typename T>
+    [[gnu::target("sse4.2")]] static std::uint32_t eqMask(const T *a, const T *b)
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm_movemask_epi8(
+                    _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))));
+        else if constexpr (std::is_same_v<T, double>)
+            return _mm_movemask_epi8(
+                    _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(a), _mm_loadu_pd(b))));
+        else
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+            if constexpr (sizeof(T) == 1)
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+            else if constexpr (sizeof(T) == 2)
+                return _mm_movemask_epi8(_mm_cmpeq_epi16(x, y));
+            else if constexpr (sizeof(T) == 4)
+                return _mm_movemask_epi8(_mm_cmpeq_epi32(x, y));
+            else
+                return _mm_movemask_epi8(_mm_cmpeq_epi64(x, y));
+        }
+    }
+
+    template<typename T>
+    [[gnu::target("sse4.2")]] static std::size_t find(const T *p, std::size_t n, T value)
+    {
+        constexpr std::size_t lanes = kBytes / sizeof(T);
+        T splat[lanes];
+        std::fill_n(splat, lanes, value);
+
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            if (std::uint32_t mask = eqMask(p + i, splat))
+                return i + std::countr_zero(mask) / sizeof(T);
+        }
+        for (; i != n; i++)
+            if (p[i] == value)
+                return i;
+        return n;
+    }
+
+    template<typename T>
+    [[gnu::target("sse4.2")]] static std::size_t count(const T *p, std::size_t n, T value)
+    {
+        constexpr std::size_t lanes = kBytes / sizeof(T);
+        T splat[lanes];
+        std::fill_n(splat, lanes, value);
+
+        std::size_t bits = 0, i = 0;
+        for (; i + lanes <= n; i += lanes)
+            bits += std::popcount(eqMask(p + i, splat));
+
+        std::size_t total = bits / sizeof(T);
+        for (; i != n; i++)
+            total += p[i] == value;
+        return total;
+    }
+
+    template<typename T>
+    [[gnu::target("sse4.2")]] static std::size_t mismatch(const T *a,
+                                                          const T *b,
+                                                          std::size_t n)
+    {
+        constexpr std::size_t lanes = kBytes / sizeof(T);
+
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            if (std::uint32_t mask = ~eqMask(a + i, b + i) & 0xffff)
+                return i + std::countr_zero(mask) / sizeof(T);
+        }
+        for (; i != n; i++)
+            if (!(a[i] == b[i]))
+                return i;
+        return n;
+    }
+};
+
+#endif   // _LIBPOWERCXX_SIMD_X86
+
+/// Index of the first element equal to value, or n.
+template<typename T>
+constexpr std::size_t simdFind(const T *p, std::size_t n, const T &value)
+{
+#ifdef _LIBPOWERCXX_SIMD_X86
+    if constexpr (isSimdSearchable<T>)
+    {
+        if (!std::is_constant_evaluated())   // the kernels only run at run time
+        {
+            switch (simdLevel())
+            {
+                case SimdLevel::Avx2: return Avx2Kernels::find(p, n, value);
+                case SimdLevel::Sse42: return Sse42Kernels::find(p, n, value);
+                case SimdLevel::Scalar: break;
+            }
+        }
+    }
+#endif
+    return std::find(p, p + n, value) - p;
+}
+
+/// Number of elements equal to value.
+template<typename T>
+constexpr std::size_t simdCount(const T *p, std::size_t n, const T &value)
+{
+#ifdef _LIBPOWERCXX_SIMD_X86
+    if constexpr (isSimdSearchable<T>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            switch (simdLevel())
+            {
+                case SimdLevel::Avx2: return Avx2Kernels::count(p, n, value);
+                case SimdLevel::Sse42: return Sse42Kernels::count(p, n, value);
+                case SimdLevel::Scalar: break;
+            }
+        }
+    }
+#endif
+    return std::count(p, p + n, value);
+}
+
+/// Index of the first position where a and b differ, or n.
+template<typename T>
+constexpr std::size_t simdMismatch(const T *a, const T *b, std::size_t n)
+{
+#ifdef _LIBPOWERCXX_SIMD_X86
+    if constexpr (isSimdSearchable<T>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            switch (simdLevel())
+            {
+                case SimdLevel::Avx2: return Avx2Kernels::mismatch(a, b, n);
+                case SimdLevel::Sse42: return Sse42Kernels::mismatch(a, b, n);
+                case SimdLevel::Scalar: break;
+            }
+        }
+    }
+#endif
+    return std::mismatch(a, a + n, b).first - a;
+}
+
+template<typename T>
+constexpr bool simdEqual(const T *a, std::size_t na, const T *b, std::size_t nb)
+{
+    return na == nb && simdMismatch(a, b, na) == na;
+}
+
+/// Lexicographical three-way comparison, with the same result as
+/// std::lexicographical_compare_three_way over the two ranges.
+template<typename T>
+constexpr std::compare_three_way_result_t<T> simdCompareThreeWay(const T *a,
+                                                                 std::size_t na,
+                                                                 const T *b,
+                                                                 std::size_t nb)
+{
+    if constexpr (!isSimdSearchable<T>)
+        return std::lexicographical_compare_three_way(a, a + na, b, b + nb);
+    else
+    {
+        std::size_t n = std::min(na, nb);
+        std::size_t i = simdMismatch(a, b, n);
+        if (i != n)
+            return a[i] <=> b[i];
+        return na <=> nb;
+    }
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Relocate.hpp"
+#include "Vector.hpp"
+
+/// Allocator carrying N elements of inline storage. It never hands the inline buffer
+/// out from allocate(): SmallVector points its data at it directly, and deallocate()
+/// simply ignores it, so Vector's growth path works unchanged.
+template<typename T, std::size_t N, typename Upstream = std::allocator<T>>
+struct InlineAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = InlineAllocator<
+                U,
+                N,
+                typename std::allocator_traits<Upstream>::template rebind_alloc<U>>;
+    };
+
+    alignas(T) std::byte mBuffer[N * sizeof(T)];
+    [[no_unique_address]] Upstream mUpstream;
+
+    InlineAllocator() noexcept = default;
+
+    InlineAllocator(const Upstream &upstream) noexcept : mUpstream(upstream) { }
+
+    // the buffer belongs to one container, so copies only carry the upstream allocator
+    InlineAllocator(const InlineAllocator &that) noexcept : mUpstream(that.mUpstream) { }
+
+    InlineAllocator &operator=(const InlineAllocator &that) noexcept
+    {
+        mUpstream = that.mUpstream;
+        return *this;
+    }
+
+    T *buffer() noexcept { return reinterpret_cast<T *>(mBuffer); }
+
+    const T *buffer() const noexcept { return reinterpret_cast<const T *>(mBuffer); }
+
+    T *allocate(std::size_t n) { return mUpstream.allocate(n); }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        if (p != buffer())
+            mUpstream.deallocate(p, n);
+    }
+
+    bool operator==(const InlineAllocator &that) const noexcept { return this == &that; }
+};
+
+/// Vector holding up to N elements inline, spilling to Alloc only beyond that.
+template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+struct SmallVector : Vector<T, InlineAllocator<T, N, Alloc>>
+{
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+    using Base           = Vector<T, InlineAllocator<T, N, Alloc>>;
+    using allocator_type = Alloc;
+
+    using Base::mAlloc;
+    using Base::mCap;
+    using Base::mData;
+    using Base::mSize;
+
+    static constexpr std::size_t inline_capacity() noexcept { return N; }
+
+    SmallVector() noexcept { resetInline(); }
+
+    explicit SmallVector(const Alloc &alloc) noexcept
+    {
+        mAlloc.mUpstream = alloc;
+        resetInline();
+    }
+
+    explicit SmallVector(std::size_t n, const Alloc &alloc = Alloc()) : SmallVector(alloc)
+    {
+        this->resize(n);
+    }
+
+    SmallVector(std::size_t n, const T &value, const Alloc &alloc = Alloc())
+        : SmallVector(alloc)
+    {
+        this->insert(this->end(), n, value);
+    }
+
+    template<std::random_access_iterator InputIt>
+    SmallVector(InputIt first, InputIt last, const Alloc &alloc = Alloc())
+        : SmallVector(alloc)
+    {
+        this->insert(this->end(), first, last);
+    }
+
+    SmallVector(std::initializer_list<T> ilist, const Alloc &alloc = Alloc())
+        : SmallVector(ilist.begin(), ilist.end(), alloc)
+    { }
+
+    SmallVector(const SmallVector &that) : SmallVector(that.mAlloc.mUpstream)
+    {
+        this->insert(this->end(), that.begin(), that.end());
+    }
+
+    SmallVector(SmallVector &&that) noexcept(nothrowRelocate)
+        : SmallVector(that.mAlloc.mUpstream)
+    {
+        uninitMoveAssign(std::move(that));
+    }
+
+    SmallVector &operator=(const SmallVector &that)
+    {
+        if (&that == this) [[unlikely]]
+            return *this;
+
+        this->clear();
+        this->insert(this->end(), that.begin(), that.end());
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&that) noexcept(nothrowRelocate)
+    {
+        if (&that == this) [[unlikely]]
+            return *this;
+
+        this->clear();
+        if (!isInline())
+        {
+            mAlloc.deallocate(mData, mCap);
+            resetInline();
+        }
+        mAlloc.mUpstream = that.mAlloc.mUpstream;
+        uninitMoveAssign(std::move(that));
+        return *this;
+    }
+
+    SmallVector &operator=(std::initializer_list<T> ilist)
+    {
+        this->clear();
+        this->insert(this->end(), ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    bool isInline() const noexcept { return mData == mAlloc.buffer(); }
+
+    /// Move back into the inline buffer when the elements fit, otherwise shrink the heap
+    /// block as Vector does.
+    void shrink_to_fit()
+    {
+        if (isInline())
+            return;
+
+        if (mSize > N)
+        {
+            Base::shrink_to_fit();
+            return;
+        }
+
+        T *oldData         = mData;
+        std::size_t oldCap = mCap;
+        resetInline();
+        uninitRelocate(oldData, oldData + mSize, mData);
+        mAlloc.deallocate(oldData, oldCap);
+    }
+
+    void swap(SmallVector &that) noexcept(nothrowRelocate)
+    {
+        SmallVector tmp(std::move(that));
+        that  = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    Alloc get_allocator() const noexcept { return mAlloc.mUpstream; }
+
+  private:
+    static constexpr bool nothrowRelocate =
+            isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>;
+
+    void resetInline() noexcept
+    {
+        mData = mAlloc.buffer();
+        mCap  = N;
+    }
+
+    /// Take over that's elements; *this must be empty and inline. Heap blocks are
+    /// stolen, inline elements are relocated into our own buffer.
+    void uninitMoveAssign(SmallVector &&that) noexcept(nothrowRelocate)
+    {
+        if (that.isInline())
+            uninitRelocate(that.mData, that.mData + that.mSize, mData);
+        else
+        {
+            mData = that.mData;
+            mCap  = that.mCap;
+            that.resetInline();
+        }
+        mSize      = that.mSize;
+        that.mSize = 0;
+    }
+};
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Relocate.hpp"
+#include "VectorPolicy.hpp"
+
+/// Struct-of-arrays counterpart of Vector<std::tuple<Fields...>>: every field lives in
+/// its own contiguous column, so a loop over one field touches only that field's bytes.
+/// Columns are exposed as spans; rows are accessed through a tuple of references.
+/// Capacity grows exactly like Vector (DoublingGrowth), all columns together.
+template<typename... Fields>
+struct SoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    using value_type      = std::tuple<Fields...>;
+    using reference       = std::tuple<Fields &...>;
+    using const_reference = std::tuple<const Fields &...>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<std::size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+  private:
+    using Indices = std::index_sequence_for<Fields...>;
+
+    std::tuple<Fields *...> mColumns {};
+    std::size_t mSize = 0;
+    std::size_t mCap  = 0;
+
+  public:
+    SoAVector() noexcept = default;
+
+    SoAVector(const SoAVector &that) { copyFrom(that, Indices {}); }
+
+    SoAVector(SoAVector &&that) noexcept
+        : mColumns(std::exchange(that.mColumns, {})),
+          mSize(std::exchange(that.mSize, 0)),
+          mCap(std::exchange(that.mCap, 0))
+    { }
+
+    SoAVector &operator=(SoAVector that) noexcept
+    {
+        swap(that);
+        return *this;
+    }
+
+    ~SoAVector() noexcept
+    {
+        clear();
+        deallocate(mColumns, mCap, Indices {});
+    }
+
+    void swap(SoAVector &that) noexcept
+    {
+        std::swap(mColumns, that.mColumns);
+        std::swap(mSize, that.mSize);
+        std::swap(mCap, that.mCap);
+    }
+
+    std::size_t size() const noexcept { return mSize; }
+
+    std::size_t capacity() const noexcept { return mCap; }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    void clear() noexcept
+    {
+        destroy(0, mSize, Indices {});
+        mSize = 0;
+    }
+
+    void reserve(std::size_t n)
+    {
+        if (n <= mCap)
+            return;
+
+        reallocate(std::max<std::size_t>(n, DoublingGrowth {}(mCap, n)), Indices {});
+    }
+
+    void shrink_to_fit()
+    {
+        if (mSize != mCap)
+            reallocate(mSize, Indices {});
+    }
+
+    /// Append one row, constructing field I from args[I].
+    template<typename... Args>
+        requires(sizeof...(Args) == sizeof...(Fields))
+    reference emplace_back(Args &&...args)
+    {
+        if (mSize == mCap) [[unlikely]]
+            reserve(mSize + 1);
+
+        constructRow(mSize, Indices {}, std::forward<Args>(args)...);
+        return (*this)[mSize++];
+    }
+
+    void push_back(const Fields &...fields) { emplace_back(fields...); }
+
+    void push_back(const value_type &row)
+    {
+        std::apply([this](const Fields &...fields) { emplace_back(fields...); }, row);
+    }
+
+    void pop_back() noexcept
+    {
+        mSize -= 1;
+        destroy(mSize, mSize + 1, Indices {});
+    }
+
+    template<std::size_t I>
+    std::span<field_type<I>> column() noexcept
+    {
+        return {std::get<I>(mColumns), mSize};
+    }
+
+    template<std::size_t I>
+    std::span<const field_type<I>> column() const noexcept
+    {
+        return {std::get<I>(mColumns), mSize};
+    }
+
+    reference operator[](std::size_t i) noexcept
+    {
+        return std::apply([i](Fields *...cols) { return reference {cols[i]...}; },
+                          mColumns);
+    }
+
+    const_reference operator[](std::size_t i) const noexcept
+    {
+        return std::apply([i](Fields *...cols) { return const_reference {cols[i]...}; },
+                          mColumns);
+    }
+
+    reference at(std::size_t i)
+    {
+        if (i >= mSize) [[unlikely]]
+            throw std::out_of_range("SoAVector at function");
+        return (*this)[i];
+    }
+
+    const_reference at(std::size_t i) const
+    {
+        if (i >= mSize) [[unlikely]]
+            throw std::out_of_range("SoAVector at function");
+        return (*this)[i];
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+
+    const_reference front() const noexcept { return (*this)[0]; }
+
+    reference back() noexcept { return (*this)[mSize - 1]; }
+
+    const_reference back() const noexcept { return (*this)[mSize - 1]; }
+
+    /// Random-access iterator over rows; dereferencing yields a reference proxy.
+    template<bool Const>
+    struct RowIterator
+    {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = SoAVector::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const,
+                                                     SoAVector::const_reference,
+                                                     SoAVector::reference>;
+        using owner_pointer = std::conditional_t<Const, const SoAVector *, SoAVector *>;
+
+        owner_pointer mOwner = nullptr;
+        std::size_t mIndex   = 0;
+
+        reference operator*() const noexcept { return (*mOwner)[mIndex]; }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return (*mOwner)[mIndex + n];
+        }
+
+        RowIterator &operator++() noexcept
+        {
+            ++mIndex;
+            return *this;
+        }
+
+        RowIterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++mIndex;
+            return tmp;
+        }
+
+        RowIterator &operator--() noexcept
+        {
+            --mIndex;
+            return *this;
+        }
+
+        RowIterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --mIndex;
+            return tmp;
+        }
+
+        RowIterator &operator+=(difference_type n) noexcept
+        {
+            mIndex += n;
+            return *this;
+        }
+
+        RowIterator &operator-=(difference_type n) noexcept
+        {
+            mIndex -= n;
+            return *this;
+        }
+
+        RowIterator operator+(difference_type n) const noexcept
+        {
+            return {mOwner, mIndex + n};
+        }
+
+        RowIterator operator-(difference_type n) const noexcept
+        {
+            return {mOwner, mIndex - n};
+        }
+
+        difference_type operator-(const RowIterator &that) const noexcept
+        {
+            return static_cast<difference_type>(mIndex - that.mIndex);
+        }
+
+        bool operator==(const RowIterator &that) const noexcept
+        {
+            return mIndex == that.mIndex;
+        }
+
+        auto operator<=>(const RowIterator &that) const noexcept
+        {
+            return mIndex <=> that.mIndex;
+        }
+    };
+
+    using iterator       = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+
+    iterator begin() noexcept { return {this, 0}; }
+
+    iterator end() noexcept { return {this, mSize}; }
+
+    const_iterator begin() const noexcept { return {this, 0}; }
+
+    const_iterator end() const noexcept { return {this, mSize}; }
+
+    const_iterator cbegin() const noexcept { return {this, 0}; }
+
+    const_iterator cend() const noexcept { return {this, mSize}; }
+
+  private:
+    template<std::size_t... I, typename... Args>
+    void constructRow(std::size_t i, std::index_sequence<I...>, Args &&...args)
+    {
+        // construct field by field, undoing the finished ones if a later one throws
+        std::size_t built = 0;
+        try
+        {
+            ((std::construct_at(std::get<I>(mColumns) + i, std::forward<Args>(args)),
+              ++built),
+             ...);
+        }
+        catch (...)
+        {
+            ((I < built ? std::destroy_at(std::get<I>(mColumns) + i) : void()), ...);
+            throw;
+        }
+    }
+
+    template<std::size_t... I>
+    void destroy(std::size_t first, std::size_t last, std::index_sequence<I...>) noexcept
+    {
+        (std::destroy(std::get<I>(mColumns) + first, std::get<I>(mColumns) + last), ...);
+    }
+
+    template<std::size_t... I>
+    static void deallocate(std::tuple<Fields *...> &cols,
+                           std::size_t cap,
+                           std::index_sequence<I...>) noexcept
+    {
+        if (cap != 0)
+            (std::allocator<Fields>().deallocate(std::get<I>(cols), cap), ...);
+    }
+
+    /// Allocate every new column before relocating any, so a failed allocation leaves
+    /// the vector untouched.
+    template<std::size_t... I>
+    void reallocate(std::size_t n, std::index_sequence<I...>)
+    {
+        std::tuple<Fields *...> fresh {};
+        if (n != 0)
+        {
+            std::size_t allocated = 0;
+            try
+            {
+                ((std::get<I>(fresh) = std::allocator<Fields>().allocate(n), ++allocated),
+                 ...);
+            }
+            catch (...)
+            {
+                ((I < allocated
+                          ? std::allocator<Fields>().deallocate(std::get<I>(fresh), n)
+                          : void()),
+                 ...);
+                throw;
+            }
+        }
+
+        (uninitRelocate(std::get<I>(mColumns),
+                        std::get<I>(mColumns) + mSize,
+                        std::get<I>(fresh)),
+         ...);
+        deallocate(mColumns, mCap, Indices {});
+        mColumns = fresh;
+        mCap     = n;
+    }
+
+    template<std::size_t... I>
+    void copyFrom(const SoAVector &that, std::index_sequence<I...>)
+    {
+        reserve(that.mSize);
+        try
+        {
+            for (; mSize != that.mSize; mSize++)
+                constructRow(mSize, Indices {}, std::get<I>(that.mColumns)[mSize]...);
+        }
+        catch (...)
+        {
+            clear();
+            deallocate(mColumns, mCap, Indices {});
+            throw;
+        }
+    }
+};
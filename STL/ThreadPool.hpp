@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Function.hpp"
+
+/// Fixed set of worker threads draining a FIFO of tasks.
+struct ThreadPool
+{
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+    {
+        threads = std::max<std::size_t>(threads, 1);
+        m_workers.reserve(threads);
+        for (std::size_t i = 0; i != threads; i++)
+            m_workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ThreadPool(const ThreadPool &)            = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+        for (auto &worker: m_workers)
+            worker.join();
+    }
+
+    std::size_t size() const noexcept { return m_workers.size(); }
+
+    void submit(Function<void()> task)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_wakeup.notify_one();
+    }
+
+    /// Shared pool sized to the machine, created on first use.
+    static ThreadPool &global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+  private:
+    void workerLoop()
+    {
+        for (;;)
+        {
+            Function<void()> task;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wakeup.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_tasks.empty())
+                    return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque<Function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stopping = false;
+};
+
+/// Call fn(chunk) for every chunk in [0, chunks), spread over the pool and the calling
+/// thread, and return once all of them have finished. The caller claims chunks too, so
+/// this makes progress even when every worker is busy (or it is called from one).
+/// fn must not throw; callers that can fail record it per chunk themselves.
+template<typename Fn>
+void parallelFor(ThreadPool &pool, std::size_t chunks, Fn &&fn)
+{
+    struct State
+    {
+        std::atomic<std::size_t> next {0};
+        std::size_t chunks;
+        std::latch done;
+        std::remove_reference_t<Fn> *fn;
+
+        State(std::size_t n, std::remove_reference_t<Fn> *f)
+            : chunks(n), done(static_cast<std::ptrdiff_t>(n)), fn(f)
+        { }
+
+        // fn is only touched after claiming a chunk, i.e. while the caller still waits
+        void drain() noexcept
+        {
+            for (std::size_t i; (i = next.fetch_add(1)) < chunks;)
+            {
+                (*fn)(i);
+                done.count_down();
+            }
+        }
+    };
+
+    if (chunks == 0)
+        return;
+
+    auto state = std::make_shared<State>(chunks, &fn);
+    for (std::size_t i = 1; i < std::min(chunks, pool.size() + 1); i++)
+        pool.submit([state] { state->drain(); });
+
+    state->drain();
+    state->done.wait();
+}
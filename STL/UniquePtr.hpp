@@ -2,8 +2,11 @@
 
 #include <concepts>
 #include <cstdio>
+#include <type_traits>
 #include <utility>
 
+#include "Relocate.hpp"
+
 template<typename T>
 struct DefaultDeleter
 {
@@ -97,6 +100,12 @@ template<typename T, typename Deleter>
 struct UniquePtr<T[], Deleter> : UniquePtr<T, Deleter>
 { };
 
+/// A UniquePtr with a stateless deleter is just an owning pointer, so relocating it is a
+/// plain copy of that pointer.
+template<typename T, typename Deleter>
+struct IsTriviallyRelocatable<UniquePtr<T, Deleter>> : std::is_empty<Deleter>
+{ };
+
 template<typename T, typename... Args>
 UniquePtr<T> makeUnique(Args &&...args)
 {
@@ -0,0 +1,550 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Relocate.hpp"
+
+/// Elements per block when none is given: about 256 bytes of payload, at least 4.
+template<typename T>
+inline constexpr std::size_t kDefaultUnroll = sizeof(T) >= 64 ? 4 : 256 / sizeof(T);
+
+/// Doubly linked list of small arrays. Each block holds up to K elements, so a
+/// traversal follows one pointer per block instead of one per element. Inserting into
+/// a full block splits it in half, and a block left less than half full by erase
+/// absorbs its successor when both fit. Insertion and erase at a known position cost
+/// O(K).
+///
+/// Iterators are bidirectional like List's. Insertion and erase invalidate iterators
+/// into the blocks they touch (the block itself and any block split from or merged
+/// into it); iterators into other blocks stay valid.
+template<typename T,
+         std::size_t K  = kDefaultUnroll<T>,
+         typename Alloc = std::allocator<T>>
+struct UnrolledList
+{
+    static_assert(K >= 2, "a block must hold at least two elements");
+    static_assert(isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>,
+                  "elements are shifted inside blocks by noexcept operations");
+
+    using value_type      = T;
+    using allocator_type  = Alloc;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = T *;
+    using const_pointer   = const T *;
+    using reference       = T &;
+    using const_reference = const T &;
+
+  private:
+    struct BlockBase
+    {
+        BlockBase *next;
+        BlockBase *prev;
+        std::size_t count;   // the sentinel keeps 0
+    };
+
+    struct Block : BlockBase
+    {
+        union
+        {
+            T items[K];
+        };
+
+        Block() noexcept { }
+
+        ~Block() { }
+    };
+
+    using AllocBlock = std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+
+    BlockBase mDummy;
+    std::size_t mSize;
+    [[no_unique_address]] AllocBlock mAlloc;
+
+    static T *items(BlockBase *b) noexcept { return static_cast<Block *>(b)->items; }
+
+    static const T *items(const BlockBase *b) noexcept
+    {
+        return static_cast<const Block *>(b)->items;
+    }
+
+    /// Allocate an empty block and link it in after `after`.
+    BlockBase *linkNewBlock(BlockBase *after)
+    {
+        Block *b          = std::construct_at(mAlloc.allocate(1));
+        b->count          = 0;
+        b->prev           = after;
+        b->next           = after->next;
+        after->next->prev = b;
+        after->next       = b;
+        return b;
+    }
+
+    void unlinkBlock(BlockBase *b) noexcept
+    {
+        b->prev->next = b->next;
+        b->next->prev = b->prev;
+        std::destroy_at(static_cast<Block *>(b));
+        mAlloc.deallocate(static_cast<Block *>(b), 1);
+    }
+
+    void resetDummy() noexcept
+    {
+        mDummy.next = mDummy.prev = &mDummy;
+        mDummy.count              = 0;
+        mSize                     = 0;
+    }
+
+    /// Construct an element at index i of block b, or of the block a full b splits
+    /// into or gives way to; b and i are left pointing at the new element.
+    template<typename... Args>
+    void emplaceAt(BlockBase *&b, std::size_t &i, Args &&...args)
+    {
+        if (b == &mDummy)   // empty list
+        {
+            b = linkNewBlock(&mDummy);
+            i = 0;
+        }
+        else if (b->count == K)
+        {
+            if (i == K)   // appending: start a fresh block instead of splitting
+            {
+                b = linkNewBlock(b);
+                i = 0;
+            }
+            else if (i == 0)
+            {
+                b = linkNewBlock(b->prev);
+            }
+            else
+            {
+                BlockBase *upper = linkNewBlock(b);
+                std::size_t half = K / 2;
+                uninitRelocate(items(b) + half, items(b) + K, items(upper));
+                upper->count = K - half;
+                b->count     = half;
+                if (i > half)
+                {
+                    b = upper;
+                    i -= half;
+                }
+            }
+        }
+
+        T *slot = items(b) + i;
+        relocateRight(slot, items(b) + b->count, 1);
+        try
+        {
+            std::construct_at(slot, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            relocateLeft(slot + 1, items(b) + b->count + 1, slot);
+            if (b->count == 0)
+                unlinkBlock(b);
+            throw;
+        }
+        b->count += 1;
+        mSize += 1;
+    }
+
+  public:
+    UnrolledList() noexcept { resetDummy(); }
+
+    explicit UnrolledList(const Alloc &alloc) noexcept : mAlloc(alloc) { resetDummy(); }
+
+    template<std::input_iterator InputIt>
+    UnrolledList(InputIt first, InputIt last, const Alloc &alloc = Alloc())
+        : UnrolledList(alloc)
+    {
+        try
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    UnrolledList(std::initializer_list<T> ilist, const Alloc &alloc = Alloc())
+        : UnrolledList(ilist.begin(), ilist.end(), alloc)
+    { }
+
+    UnrolledList(const UnrolledList &that)
+        : UnrolledList(that.cbegin(), that.cend(), Alloc(that.mAlloc))
+    { }
+
+    UnrolledList(UnrolledList &&that) noexcept : mAlloc(std::move(that.mAlloc))
+    {
+        resetDummy();
+        swapNodes(that);
+    }
+
+    UnrolledList &operator=(UnrolledList that) noexcept
+    {
+        clear();
+        mAlloc = std::move(that.mAlloc);
+        swapNodes(that);
+        return *this;
+    }
+
+    ~UnrolledList() noexcept { clear(); }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    std::size_t size() const noexcept { return mSize; }
+
+    /// Number of blocks currently allocated.
+    std::size_t block_count() const noexcept
+    {
+        std::size_t n = 0;
+        for (const BlockBase *b = mDummy.next; b != &mDummy; b = b->next)
+            ++n;
+        return n;
+    }
+
+    static constexpr std::size_t block_capacity() noexcept { return K; }
+
+    T &front() noexcept { return items(mDummy.next)[0]; }
+
+    const T &front() const noexcept { return items(mDummy.next)[0]; }
+
+    T &back() noexcept { return items(mDummy.prev)[mDummy.prev->count - 1]; }
+
+    const T &back() const noexcept { return items(mDummy.prev)[mDummy.prev->count - 1]; }
+
+    void clear() noexcept
+    {
+        BlockBase *b = mDummy.next;
+        while (b != &mDummy)
+        {
+            BlockBase *next = b->next;
+            std::destroy(items(b), items(b) + b->count);
+            std::destroy_at(static_cast<Block *>(b));
+            mAlloc.deallocate(static_cast<Block *>(b), 1);
+            b = next;
+        }
+        resetDummy();
+    }
+
+    struct iterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+
+      private:
+        BlockBase *mNode;
+        std::size_t mIndex;
+
+        friend UnrolledList;
+
+        iterator(BlockBase *node, std::size_t index) noexcept
+            : mNode(node), mIndex(index)
+        { }
+
+      public:
+        iterator() = default;
+
+        // ++iterator
+        iterator &operator++() noexcept
+        {
+            if (++mIndex == mNode->count)
+            {
+                mNode  = mNode->next;
+                mIndex = 0;
+            }
+            return *this;
+        }
+
+        // iterator++
+        iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // --iterator
+        iterator &operator--() noexcept
+        {
+            if (mIndex == 0)
+            {
+                mNode  = mNode->prev;
+                mIndex = mNode->count;
+            }
+            --mIndex;
+            return *this;
+        }
+
+        // iterator--
+        iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        T &operator*() const noexcept { return items(mNode)[mIndex]; }
+
+        T *operator->() const noexcept { return &items(mNode)[mIndex]; }
+
+        bool operator==(const iterator &that) const noexcept
+        {
+            return mNode == that.mNode && mIndex == that.mIndex;
+        }
+
+        bool operator!=(const iterator &that) const noexcept { return !(*this == that); }
+    };
+
+    struct const_iterator
+    {
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T *;
+        using reference         = const T &;
+
+      private:
+        const BlockBase *mNode;
+        std::size_t mIndex;
+
+        friend UnrolledList;
+
+        const_iterator(const BlockBase *node, std::size_t index) noexcept
+            : mNode(node), mIndex(index)
+        { }
+
+      public:
+        const_iterator() = default;
+
+        const_iterator(iterator that) noexcept : mNode(that.mNode), mIndex(that.mIndex)
+        { }
+
+        explicit operator iterator() noexcept
+        {
+            return iterator {const_cast<BlockBase *>(mNode), mIndex};
+        }
+
+        // ++iterator
+        const_iterator &operator++() noexcept
+        {
+            if (++mIndex == mNode->count)
+            {
+                mNode  = mNode->next;
+                mIndex = 0;
+            }
+            return *this;
+        }
+
+        // iterator++
+        const_iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // --iterator
+        const_iterator &operator--() noexcept
+        {
+            if (mIndex == 0)
+            {
+                mNode  = mNode->prev;
+                mIndex = mNode->count;
+            }
+            --mIndex;
+            return *this;
+        }
+
+        // iterator--
+        const_iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        const T &operator*() const noexcept { return items(mNode)[mIndex]; }
+
+        const T *operator->() const noexcept { return &items(mNode)[mIndex]; }
+
+        bool operator==(const const_iterator &that) const noexcept
+        {
+            return mNode == that.mNode && mIndex == that.mIndex;
+        }
+
+        bool operator!=(const const_iterator &that) const noexcept
+        {
+            return !(*this == that);
+        }
+    };
+
+    iterator begin() noexcept { return iterator {mDummy.next, 0}; }
+
+    iterator end() noexcept { return iterator {&mDummy, 0}; }
+
+    const_iterator cbegin() const noexcept { return const_iterator {mDummy.next, 0}; }
+
+    const_iterator cend() const noexcept { return const_iterator {&mDummy, 0}; }
+
+    const_iterator begin() const noexcept { return cbegin(); }
+
+    const_iterator end() const noexcept { return cend(); }
+
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return std::make_reverse_iterator(cend());
+    }
+
+    const_reverse_iterator crend() const noexcept
+    {
+        return std::make_reverse_iterator(cbegin());
+    }
+
+    const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+
+    const_reverse_iterator rend() const noexcept { return crend(); }
+
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args)
+    {
+        BlockBase *b  = const_cast<BlockBase *>(pos.mNode);
+        std::size_t i = pos.mIndex;
+
+        // the slot just past a block's last element is also the one before the next
+        // block's first: prefer whichever block has room
+        if (b == &mDummy || (i == 0 && b->prev != &mDummy && b->prev->count < K))
+        {
+            b = b->prev;
+            i = b->count;
+        }
+
+        // inserting before elements of b moves them, and args may refer to one of
+        // them: build the value before anything moves and move it in
+        if (b != &mDummy && i < b->count)
+        {
+            T value(std::forward<Args>(args)...);
+            emplaceAt(b, i, std::move(value));
+        }
+        else
+            emplaceAt(b, i, std::forward<Args>(args)...);
+        return iterator {b, i};
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+
+    iterator insert(const_iterator pos, T &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        return *emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    T &emplace_front(Args &&...args)
+    {
+        return *emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void push_front(const T &value) { emplace_front(value); }
+
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    iterator erase(const_iterator pos) noexcept
+    {
+        BlockBase *b  = const_cast<BlockBase *>(pos.mNode);
+        std::size_t i = pos.mIndex;
+
+        T *slot = items(b) + i;
+        std::destroy_at(slot);
+        relocateLeft(slot + 1, items(b) + b->count, slot);
+        b->count -= 1;
+        mSize -= 1;
+
+        if (b->count == 0)
+        {
+            BlockBase *next = b->next;
+            unlinkBlock(b);
+            return iterator {next, 0};
+        }
+
+        BlockBase *next = b->next;
+        if (b->count < K / 2 && next != &mDummy && b->count + next->count <= K)
+        {
+            uninitRelocate(items(next), items(next) + next->count, items(b) + b->count);
+            b->count += next->count;
+            unlinkBlock(next);
+        }
+
+        if (i == b->count)
+            return iterator {b->next, 0};
+        return iterator {b, i};
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        // merging may free the block `last` points into, so count instead
+        auto n  = std::distance(first, last);
+        auto it = iterator(first);
+        while (n--)
+            it = erase(it);
+        return it;
+    }
+
+    void pop_front() noexcept { erase(cbegin()); }
+
+    void pop_back() noexcept { erase(std::prev(cend())); }
+
+    Alloc get_allocator() const { return Alloc(mAlloc); }
+
+    bool operator==(const UnrolledList &that) const noexcept
+    {
+        return std::equal(begin(), end(), that.begin(), that.end());
+    }
+
+  private:
+    void swapNodes(UnrolledList &that) noexcept
+    {
+        // the sentinels stay put, only the first and last blocks are relinked
+        std::swap(mDummy.next, that.mDummy.next);
+        std::swap(mDummy.prev, that.mDummy.prev);
+        std::swap(mSize, that.mSize);
+        for (UnrolledList *l: {this, &that})
+        {
+            if (l->mSize == 0)
+            {
+                l->mDummy.next = l->mDummy.prev = &l->mDummy;
+                continue;
+            }
+            l->mDummy.next->prev = &l->mDummy;
+            l->mDummy.prev->next = &l->mDummy;
+        }
+    }
+};
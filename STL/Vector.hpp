@@ -1,17 +1,44 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <compare>
 #include <cstddef>
-#include <format>
+#include <exception>
 #include <initializer_list>
-#include <iostream>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <utility>
 
-template <typename T, typename Alloc = std::allocator<T>>
+#include "Relocate.hpp"
+#include "SimdSearch.hpp"
+#include "ThreadPool.hpp"
+#include "VectorPolicy.hpp"
+
+/// Tag selecting default-initialization: trivial element types are left indeterminate
+/// instead of being zero-filled, for buffers that are overwritten right away.
+struct default_init_t
+{
+    explicit default_init_t() = default;
+};
+
+inline constexpr default_init_t default_init {};
+
+/// Tag selecting parallel construction on ThreadPool::global() for large buffers.
+struct parallel_t
+{
+    explicit parallel_t() = default;
+};
+
+inline constexpr parallel_t par {};
+
+template <typename T,
+          typename Alloc      = std::allocator<T>,
+          GrowthPolicy Growth = DoublingGrowth,
+          typename Observer   = NullObserver>
 struct Vector
 {
     using value_type             = T;
@@ -31,9 +58,15 @@ struct Vector
     std::size_t mSize;
     std::size_t mCap;
     [[no_unique_address]] Alloc mAlloc;
+    [[no_unique_address]] Growth mGrowth;
+    [[no_unique_address]] Observer mObserver;
 
     Vector() noexcept : mData(nullptr), mSize(0), mCap(0) { }
 
+    explicit Vector(const Alloc &alloc) noexcept
+        : mData(nullptr), mSize(0), mCap(0), mAlloc(alloc)
+    { }
+
     Vector(std::initializer_list<T> ilist, const Alloc &alloc = Alloc())
         : Vector(ilist.begin(), ilist.end, alloc)
     { }
@@ -46,6 +79,13 @@ struct Vector
             std::construct_at(&mData[i]);   // m_data[i] = 0
     }
 
+    Vector(std::size_t n, default_init_t, const Alloc &alloc = Alloc()) : mAlloc(alloc)
+    {
+        mData = mAlloc.allocate(n);
+        mCap = mSize = n;
+        std::uninitialized_default_construct_n(mData, n);
+    }
+
     Vector(std::size_t n, const T &value, const Alloc &alloc = Alloc()) : mAlloc(alloc)
     {
         mData = mAlloc.allocate(n);
@@ -67,7 +107,40 @@ struct Vector
         }
     }
 
-    Vector(Vector &&that) noexcept : mAlloc(std::move(that.mAlloc))
+    // Parallel counterparts of the bulk constructors. Below kParallelThreshold bytes
+    // they construct on the calling thread. If an element constructor throws, every
+    // element built so far (in any chunk) is destroyed and the block freed before the
+    // exception propagates.
+
+    static constexpr std::size_t kParallelThreshold = 4 * 1024 * 1024;
+
+    Vector(parallel_t, std::size_t n, const T &value, const Alloc &alloc = Alloc())
+        : mAlloc(alloc)
+    {
+        parallelConstruct(n, [&](std::size_t first, std::size_t last) {
+            std::uninitialized_fill(mData + first, mData + last, value);
+        });
+    }
+
+    template <std::random_access_iterator InputIt>
+    Vector(parallel_t, InputIt first, InputIt last, const Alloc &alloc = Alloc())
+        : mAlloc(alloc)
+    {
+        parallelConstruct(last - first, [&](std::size_t i, std::size_t j) {
+            std::uninitialized_copy(first + i, first + j, mData + i);
+        });
+    }
+
+    Vector(parallel_t, const Vector &that)
+        : mAlloc(that.mAlloc), mGrowth(that.mGrowth), mObserver(that.mObserver)
+    {
+        parallelConstruct(that.mSize, [&](std::size_t first, std::size_t last) {
+            std::uninitialized_copy(that.mData + first, that.mData + last, mData + first);
+        });
+    }
+
+    Vector(Vector &&that) noexcept
+        : mAlloc(std::move(that.mAlloc)), mGrowth(that.mGrowth), mObserver(that.mObserver)
     {
         mData      = that.mData;
         mSize      = that.mSize;
@@ -77,7 +150,8 @@ struct Vector
         that.mCap  = 0;
     }
 
-    Vector(Vector &&that, const Alloc &alloc) noexcept : mAlloc(alloc)
+    Vector(Vector &&that, const Alloc &alloc) noexcept
+        : mAlloc(alloc), mGrowth(that.mGrowth), mObserver(that.mObserver)
     {
         mData      = that.mData;
         mSize      = that.mSize;
@@ -109,7 +183,8 @@ struct Vector
         return *this;
     }
 
-    Vector(const Vector &that) : mAlloc(that.mAlloc)
+    Vector(const Vector &that)
+        : mAlloc(that.mAlloc), mGrowth(that.mGrowth), mObserver(that.mObserver)
     {
         mCap = mSize = that.mSize;
         if (mSize != 0)
@@ -122,7 +197,8 @@ struct Vector
             mData = nullptr;
     }
 
-    Vector(const Vector &that, const Alloc &alloc) : mAlloc(alloc)
+    Vector(const Vector &that, const Alloc &alloc)
+        : mAlloc(alloc), mGrowth(that.mGrowth), mObserver(that.mObserver)
     {
         mCap = mSize = that.mSize;
         if (mSize != 0)
@@ -174,32 +250,7 @@ struct Vector
         if (n <= mCap)
             return;
 
-        n = std::max(n, mCap * 2);
-        std::cout << std::format("grow from {} to {}\n", mCap, n);
-
-        auto oldData = mData;
-        auto oldCap  = mCap;
-        if (n == 0)
-        {
-            mData = nullptr;
-            mCap  = 0;
-        }
-        else
-        {
-            mData = mAlloc.allocate(n);
-            mCap  = n;
-        }
-
-        if (oldCap != 0)
-        {
-            for (std::size_t i = 0; i != mSize; i++)
-                std::construct_at(&mData[i], std::move_if_noexcept(oldData[i]));
-
-            for (std::size_t i = 0; i != mSize; i++)
-                std::destroy_at(&oldData[i]);
-
-            mAlloc.deallocate(oldData, oldCap);
-        }
+        reallocate(std::max<std::size_t>(n, mGrowth(mCap, n)));
     }
 
     void resize(std::size_t n)
@@ -213,7 +264,7 @@ struct Vector
         else if (n > mSize)
         {
             reserve(n);
-            for (std::size_t i = 0; i != mSize; i++)
+            for (std::size_t i = mSize; i != n; i++)
                 std::construct_at(&mData[i]);
         }
         mSize = n;
@@ -230,32 +281,40 @@ struct Vector
         else if (n > mSize)
         {
             reserve(n);
-            for (std::size_t i = 0; i != mSize; i++)
+            for (std::size_t i = mSize; i != n; i++)
                 std::construct_at(&mData[i], value);
         }
         mSize = n;
     }
 
-    void shrink_to_fit() noexcept
+    void resize_for_overwrite(std::size_t n)
     {
-        auto oldData = mData;
-        auto oldCap  = mCap;
-        mCap         = mSize;
-
-        if (mSize == 0)
-            mData = nullptr;
-        else
-            mData = mAlloc.allocate(mSize);
-
-        if (oldCap != 0) [[likely]]
+        if (n < mSize)
         {
-            for (std::size_t i = 0; i != mSize; i++)
-            {
-                std::construct_at(&mData[i], std::move_if_noexcept(oldData[i]));
-                std::destroy_at(&oldData[i]);
-            }
-            mAlloc.deallocate(oldData, oldCap);
+            for (std::size_t i = n; i != mSize; i++)
+                std::destroy_at(&mData[i]);
+        }
+        else if (n > mSize)
+        {
+            reserve(n);
+            std::uninitialized_default_construct(mData + mSize, mData + n);
         }
+        mSize = n;
+    }
+
+    /// Grow by n default-initialized elements and return them, e.g. as the target of a
+    /// read() or decode step.
+    std::span<T> append_for_overwrite(std::size_t n)
+    {
+        std::size_t oldSize = mSize;
+        resize_for_overwrite(mSize + n);
+        return std::span<T>(mData + oldSize, n);
+    }
+
+    void shrink_to_fit() noexcept
+    {
+        if (mSize != mCap)
+            reallocate(mSize);
     }
 
     std::size_t capacity() const noexcept { return mCap; }
@@ -275,6 +334,8 @@ struct Vector
         std::swap(mSize, that.mSize);
         std::swap(mCap, that.mCap);
         std::swap(mAlloc, that.mAlloc);
+        std::swap(mGrowth, that.mGrowth);
+        std::swap(mObserver, that.mObserver);
     }
 
     T &operator[](std::size_t i) noexcept { return mData[i]; }
@@ -391,11 +452,20 @@ struct Vector
     T *erase(const T *it) noexcept(std::is_nothrow_move_assignable_v<T>)
     {
         std::size_t i = it - mData;
-        for (std::size_t j = i + 1; j != mSize; j++)
-            mData[j - 1] = std::move(mData[j]);
+        if constexpr (isTriviallyRelocatable<T>)
+        {
+            std::destroy_at(&mData[i]);
+            relocateLeft(mData + i + 1, mData + mSize, mData + i);
+            mSize -= 1;
+        }
+        else
+        {
+            for (std::size_t j = i + 1; j != mSize; j++)
+                mData[j - 1] = std::move(mData[j]);
 
-        mSize -= 1;
-        std::destroy_at(&mData[mSize]);
+            mSize -= 1;
+            std::destroy_at(&mData[mSize]);
+        }
 
         return const_cast<T *>(it);
     }
@@ -409,12 +479,22 @@ struct Vector
     T *erase(const T *first, const T *last) noexcept(std::is_nothrow_move_assignable_v<T>)
     {
         std::size_t diff = last - first;
-        for (std::size_t j = last - mData; j != mSize; j++)
-            mData[j - diff] = std::move(mData[j]);
+        if constexpr (isTriviallyRelocatable<T>)
+        {
+            T *dest = const_cast<T *>(first);
+            std::destroy(dest, dest + diff);
+            relocateLeft(dest + diff, mData + mSize, dest);
+            mSize -= diff;
+        }
+        else
+        {
+            for (std::size_t j = last - mData; j != mSize; j++)
+                mData[j - diff] = std::move(mData[j]);
 
-        mSize -= diff;
-        for (std::size_t j = mSize; j != mSize + diff; j++)
-            std::destroy_at(&mData[j]);
+            mSize -= diff;
+            for (std::size_t j = mSize; j != mSize + diff; j++)
+                std::destroy_at(&mData[j]);
+        }
 
         return const_cast<T *>(first);
     }
@@ -449,11 +529,7 @@ struct Vector
         std::size_t j = it - mData;
         reserve(mSize + 1);
         // [j, msize] => [j + 1, msize + 1]
-        for (std::size_t i = mSize; i != j; i--)
-        {
-            std::construct_at(&mData[i], std::move(mData[i - 1]));
-            std::destroy_at(&mData[i - 1]);
-        }
+        relocateRight(mData + j, mData + mSize, 1);
 
         mSize += 1;
         std::construct_at(&mData[j], std::forward<Args>(args)...);
@@ -465,11 +541,7 @@ struct Vector
         std::size_t j = it - mData;
         reserve(mSize + 1);
         // [j, msize] => [j + 1, msize + 1]
-        for (std::size_t i = mSize; i != j; i--)
-        {
-            std::construct_at(&mData[i], std::move(mData[i - 1]));
-            std::destroy_at(&mData[i - 1]);
-        }
+        relocateRight(mData + j, mData + mSize, 1);
         mSize += 1;
         std::construct_at(&mData[j], value);
         return mData + j;
@@ -480,11 +552,7 @@ struct Vector
         std::size_t j = it - mData;
         reserve(mSize + 1);
         // [j, msize] => [j + 1, msize + 1]
-        for (std::size_t i = mSize; i != j; i--)
-        {
-            std::construct_at(&mData[i], std::move(mData[i - 1]));
-            std::destroy_at(&mData[i - 1]);
-        }
+        relocateRight(mData + j, mData + mSize, 1);
         mSize += 1;
         std::construct_at(&mData[j], std::move(value));
         return mData + j;
@@ -499,11 +567,7 @@ struct Vector
         reserve(n + mSize);
 
         // [j, msize] => [j + n, msize + n]
-        for (std::size_t i = mSize; i != j; i--)
-        {
-            std::construct_at(&mData[i + n - 1], std::move(mData[i - 1]));
-            std::destroy_at(&mData[i - 1]);
-        }
+        relocateRight(mData + j, mData + mSize, n);
 
         mSize += n;
         for (std::size_t i = j; i != j + n; i++)
@@ -523,11 +587,7 @@ struct Vector
         reserve(mSize + n);
 
         // [j, msize] => [j + n, msize + n]
-        for (std::size_t i = mSize; i != j; i--)
-        {
-            std::construct_at(&mData[i + n - 1], std::move(mData[i - 1]));
-            std::destroy_at(&mData[i - 1]);
-        }
+        relocateRight(mData + j, mData + mSize, n);
 
         mSize += n;
         for (std::size_t i = j; i != j + n; i++)
@@ -546,16 +606,183 @@ struct Vector
 
     Alloc get_allocator() const noexcept { return mAlloc; }
 
-    bool operator==(const Vector &that) noexcept
+    Growth &growth_policy() noexcept { return mGrowth; }
+
+    Observer &observer() noexcept { return mObserver; }
+
+    // Searches and comparisons run SSE4.2/AVX2 kernels for arithmetic T, picked at
+    // runtime, and fall back to <algorithm> otherwise; those can throw if T's == or
+    // <=> can.
+
+    T *find(const T &value) noexcept(isNothrowSearchable<T>)
+    {
+        return mData + simdFind(mData, mSize, value);
+    }
+
+    const T *find(const T &value) const noexcept(isNothrowSearchable<T>)
+    {
+        return mData + simdFind(mData, mSize, value);
+    }
+
+    std::size_t count(const T &value) const noexcept(isNothrowSearchable<T>)
+    {
+        return simdCount(mData, mSize, value);
+    }
+
+    bool contains(const T &value) const noexcept(isNothrowSearchable<T>)
+    {
+        return simdFind(mData, mSize, value) != mSize;
+    }
+
+    bool equal(const Vector &that) const noexcept(isNothrowSearchable<T>)
+    {
+        return simdEqual(mData, mSize, that.mData, that.mSize);
+    }
+
+    std::pair<const T *, const T *> mismatch(const Vector &that) const
+            noexcept(isNothrowSearchable<T>)
+    {
+        std::size_t i = simdMismatch(mData, that.mData, std::min(mSize, that.mSize));
+        return {mData + i, that.mData + i};
+    }
+
+    auto compare(const Vector &that) const noexcept(isNothrowComparable<T>)
+    {
+        return simdCompareThreeWay(mData, mSize, that.mData, that.mSize);
+    }
+
+    bool operator==(const Vector &that) const noexcept(isNothrowSearchable<T>)
+    {
+        return equal(that);
+    }
+
+    auto operator<=>(const Vector &that) const noexcept(isNothrowComparable<T>)
+    {
+        return compare(that);
+    }
+
+  private:
+    /// Allocate n slots and fill them with construct(first, last), which builds
+    /// mData[first, last) and cleans up after itself if it throws. Large buffers are
+    /// split into one chunk per worker.
+    template <typename Construct>
+    void parallelConstruct(std::size_t n, Construct construct)
+    {
+        mData = n != 0 ? mAlloc.allocate(n) : nullptr;
+        mCap = mSize = 0;
+
+        ThreadPool &pool   = ThreadPool::global();
+        std::size_t chunks = n * sizeof(T) / kParallelThreshold;
+        chunks             = std::min(chunks, pool.size() + 1);
+        if (chunks <= 1)
+        {
+            try
+            {
+                construct(0, n);
+            }
+            catch (...)
+            {
+                if (n != 0)
+                    mAlloc.deallocate(mData, n);
+                mData = nullptr;
+                throw;
+            }
+        }
+        else
+        {
+            auto errors = std::make_unique<std::exception_ptr[]>(chunks);
+            parallelFor(pool, chunks, [&](std::size_t c) {
+                try
+                {
+                    construct(c * n / chunks, (c + 1) * n / chunks);
+                }
+                catch (...)
+                {
+                    errors[c] = std::current_exception();
+                }
+            });
+
+            for (std::size_t c = 0; c != chunks; c++)
+            {
+                if (!errors[c])
+                    continue;
+
+                for (std::size_t d = 0; d != chunks; d++)
+                {
+                    if (!errors[d])
+                        std::destroy(mData + d * n / chunks,
+                                     mData + (d + 1) * n / chunks);
+                }
+                mAlloc.deallocate(mData, n);
+                mData = nullptr;
+                std::rethrow_exception(errors[c]);
+            }
+        }
+
+        mCap = mSize = n;
+    }
+
+    /// Move the elements into a block of exactly n slots (n >= mSize) and report the
+    /// reallocation to the observer. Allocators offering try_expand (grow in place) or,
+    /// for trivially relocatable T, reallocate (resize, possibly without copying, e.g.
+    /// via mremap) are used in preference to allocate + relocate + deallocate.
+    void reallocate(std::size_t n)
     {
-        return std::equal(begin(), end(), that.begin(), that.end());
+        [[maybe_unused]] std::chrono::steady_clock::time_point start;
+        if constexpr (Observer::enabled)
+            start = std::chrono::steady_clock::now();
+
+        auto oldData          = mData;
+        auto oldCap           = mCap;
+        std::size_t relocated = mSize * sizeof(T);
+
+        if (oldCap == 0 || n == 0 || !tryResizeInPlace(n, relocated))
+        {
+            if (n == 0)
+            {
+                mData = nullptr;
+                mCap  = 0;
+            }
+            else
+            {
+                mData = mAlloc.allocate(n);
+                mCap  = n;
+            }
+
+            if (oldCap != 0)
+            {
+                uninitRelocate(oldData, oldData + mSize, mData);
+                mAlloc.deallocate(oldData, oldCap);
+            }
+        }
+
+        if constexpr (Observer::enabled)
+            mObserver(ReallocEvent {oldCap,
+                                    n,
+                                    relocated,
+                                    std::chrono::steady_clock::now() - start});
     }
 
-    auto operator<=>(const Vector &that) noexcept
+    bool tryResizeInPlace(std::size_t n, std::size_t &relocated)
     {
-        return std::lexicographical_compare_three_way(begin(),
-                                                      end(),
-                                                      that.begin(),
-                                                      that.end());
+        if constexpr (requires { mAlloc.try_expand(mData, mCap, n); })
+        {
+            if (n > mCap && mAlloc.try_expand(mData, mCap, n))
+            {
+                mCap      = n;
+                relocated = 0;
+                return true;
+            }
+        }
+
+        if constexpr (isTriviallyRelocatable<T> &&
+                      requires { mAlloc.reallocate(mData, mCap, n); })
+        {
+            mData = mAlloc.reallocate(mData, mCap, n);
+            mCap  = n;
+            return true;
+        }
+
+        return false;
     }
 };
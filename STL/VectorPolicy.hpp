@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+// Growth policies: given the current capacity and the capacity required, return the
+// capacity to allocate. Vector never allocates less than required, so a policy only
+// has to express how eagerly to over-allocate. Any stateless or stateful functor with
+// this call signature may be used.
+
+template<typename G>
+concept GrowthPolicy = requires(G g, std::size_t cap, std::size_t required) {
+    { g(cap, required) } -> std::convertible_to<std::size_t>;
+};
+
+struct DoublingGrowth
+{
+    constexpr std::size_t operator()(std::size_t cap, std::size_t required) const noexcept
+    {
+        return cap * 2 > required ? cap * 2 : required;
+    }
+};
+
+struct HalfGrowth
+{   // 1.5x: lets a freed block be reused by a later growth step
+    constexpr std::size_t operator()(std::size_t cap, std::size_t required) const noexcept
+    {
+        std::size_t next = cap + cap / 2;
+        return next > required ? next : required;
+    }
+};
+
+template<std::size_t Step>
+struct FixedStepGrowth
+{
+    static_assert(Step > 0, "growth step must be positive");
+
+    constexpr std::size_t operator()(std::size_t cap, std::size_t required) const noexcept
+    {
+        return cap + Step > required ? cap + Step : required;
+    }
+};
+
+// Reallocation observers: Vector reports each reallocation to its Observer. Observers
+// whose `enabled` is false are never called and the timing around the call is not
+// compiled in, so the default NullObserver costs nothing.
+
+struct ReallocEvent
+{
+    std::size_t oldCap;
+    std::size_t newCap;
+    std::size_t bytesMoved;
+    std::chrono::nanoseconds elapsed;
+};
+
+struct NullObserver
+{
+    static constexpr bool enabled = false;
+
+    void operator()(const ReallocEvent &) const noexcept { }
+};
+
+/// Counter block shared by any number of vectors and threads; updates are relaxed
+/// atomics, so recording never takes a lock.
+struct ReallocStats
+{
+    std::atomic<std::uint64_t> count {0};
+    std::atomic<std::uint64_t> bytesMoved {0};
+    std::atomic<std::uint64_t> totalNanos {0};
+    std::atomic<std::uint64_t> maxNanos {0};
+    std::atomic<std::uint64_t> maxCap {0};
+
+    void record(const ReallocEvent &event) noexcept
+    {
+        auto nanos = static_cast<std::uint64_t>(event.elapsed.count());
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytesMoved.fetch_add(event.bytesMoved, std::memory_order_relaxed);
+        totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+        updateMax(maxNanos, nanos);
+        updateMax(maxCap, event.newCap);
+    }
+
+  private:
+    static void updateMax(std::atomic<std::uint64_t> &slot, std::uint64_t value) noexcept
+    {
+        auto curr = slot.load(std::memory_order_relaxed);
+        while (curr < value &&
+               !slot.compare_exchange_weak(curr, value, std::memory_order_relaxed))
+        { }
+    }
+};
+
+/// Observer forwarding every event into a ReallocStats block; a default-constructed
+/// recorder has no block attached and drops events.
+struct ReallocRecorder
+{
+    static constexpr bool enabled = true;
+
+    ReallocStats *stats = nullptr;
+
+    void operator()(const ReallocEvent &event) const noexcept
+    {
+        if (stats)
+            stats->record(event);
+    }
+};
@@ -0,0 +1,62 @@
+#include "AlignedArray.hpp"
+#include "Array.hpp"
+#include "Bench.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+constexpr std::size_t kMaxThreads = 64;
+
+/// Each of threads threads bumps its own counter ops times; the counters are
+/// neighbours in one array, so any sharing between them is false sharing.
+template<typename Counters>
+double run(Counters &counters, std::size_t threads, std::size_t ops)
+{
+    for (auto &c: counters)
+        c.store(0, std::memory_order_relaxed);
+    double ms = measureMs([&] {
+        std::vector<std::thread> pool;
+        for (std::size_t t = 0; t != threads; t++)
+        {
+            pool.emplace_back([&, t] {
+                for (std::size_t i = 0; i != ops; i++)
+                    counters[t].fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        for (auto &t: pool)
+            t.join();
+    });
+    for (std::size_t t = 0; t != threads; t++)
+        if (counters[t].load() != ops)
+            std::abort();
+    return ms;
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    printf("%zd increments per thread, %u hardware threads\n",
+           ops,
+           std::thread::hardware_concurrency());
+
+    using Counter = std::atomic<std::uint64_t>;
+    static Array<Counter, kMaxThreads> packed {};
+    static PaddedArray<Counter, kMaxThreads, 64> padded64 {};
+    static PaddedArray<Counter, kMaxThreads, 128> padded128 {};
+
+    for (std::size_t threads = 1; threads <= kMaxThreads; threads *= 2)
+    {
+        char name[64];
+        snprintf(name, sizeof name, "Array, %zd threads", threads);
+        report(name, run(packed, threads, ops));
+        snprintf(name, sizeof name, "PaddedArray<64>, %zd threads", threads);
+        report(name, run(padded64, threads, ops));
+        snprintf(name, sizeof name, "PaddedArray<128>, %zd threads", threads);
+        report(name, run(padded128, threads, ops));
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "ArrayExpr.hpp"
+#include "Bench.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+constexpr std::size_t kBytes = 64 * 1024;   // every set of Arrays stays in L2
+constexpr int kPasses        = 2000;
+constexpr int kRepeats       = 5;
+
+template<typename F>
+double best(F &&fn)
+{
+    double ms = measureMs(fn);
+    for (int i = 1; i < kRepeats; i++)
+        ms = std::min(ms, measureMs(fn));
+    return ms;
+}
+
+template<typename T, std::size_t N>
+void run(const char *type)
+{
+    constexpr std::size_t kCount = kBytes / sizeof(Array<T, N>);
+    std::vector<Array<T, N>> a(kCount), b(kCount), c(kCount), r(kCount);
+    for (std::size_t k = 0; k != kCount; k++)
+        for (std::size_t i = 0; i != N; i++)
+        {
+            a[k][i] = static_cast<T>((k + i) % 17) / 8;
+            b[k][i] = static_cast<T>((k * i) % 13) / 4;
+            c[k][i] = static_cast<T>(i % 5);
+        }
+
+    auto name = [&](const char *what) {
+        static std::string s;
+        s = std::string(type) + "[" + std::to_string(N) + "] " + what;
+        return s.c_str();
+    };
+
+    report(name("r = a * b + c, loop"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   for (std::size_t k = 0; k != kCount; k++)
+                       for (std::size_t i = 0; i != N; i++)
+                           r[k][i] = a[k][i] * b[k][i] + c[k][i];
+                   doNotOptimize(r[pass % kCount]);
+               }
+           }));
+    report(name("r = a * b + c, expr"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   for (std::size_t k = 0; k != kCount; k++)
+                       r[k] = a[k] * b[k] + c[k];
+                   doNotOptimize(r[pass % kCount]);
+               }
+           }));
+
+    report(name("dot, loop"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   T total = 0;
+                   for (std::size_t k = 0; k != kCount; k++)
+                   {
+                       T d = 0;
+                       for (std::size_t i = 0; i != N; i++)
+                           d += a[k][i] * b[k][i];
+                       total += d;
+                   }
+                   doNotOptimize(total);
+               }
+           }));
+    report(name("dot, expr"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   T total = 0;
+                   for (std::size_t k = 0; k != kCount; k++)
+                       total += dot(a[k], b[k]);
+                   doNotOptimize(total);
+               }
+           }));
+
+    report(name("max element, loop"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   T total = 0;
+                   for (std::size_t k = 0; k != kCount; k++)
+                   {
+                       T m = a[k][0];
+                       for (std::size_t i = 1; i != N; i++)
+                           m = std::max(m, a[k][i]);
+                       total += m;
+                   }
+                   doNotOptimize(total);
+               }
+           }));
+    report(name("max element, expr"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   T total = 0;
+                   for (std::size_t k = 0; k != kCount; k++)
+                       total += maxValue(a[k]);
+                   doNotOptimize(total);
+               }
+           }));
+
+    report(name("fill, loop"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   for (std::size_t k = 0; k != kCount; k++)
+                       for (std::size_t i = 0; i != N; i++)
+                           r[k][i] = static_cast<T>(pass);
+                   doNotOptimize(r[pass % kCount]);
+               }
+           }));
+    report(name("fill, Array::fill"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   for (std::size_t k = 0; k != kCount; k++)
+                       r[k].fill(static_cast<T>(pass));
+                   doNotOptimize(r[pass % kCount]);
+               }
+           }));
+
+    report(name("swap, loop"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   for (std::size_t k = 0; k != kCount; k++)
+                       for (std::size_t i = 0; i != N; i++)
+                           std::swap(a[k][i], c[k][i]);
+                   doNotOptimize(a[pass % kCount]);
+               }
+           }));
+    report(name("swap, Array::swap"), best([&] {
+               for (int pass = 0; pass < kPasses; pass++)
+               {
+                   for (std::size_t k = 0; k != kCount; k++)
+                       a[k].swap(c[k]);
+                   doNotOptimize(a[pass % kCount]);
+               }
+           }));
+}
+
+int main()
+{
+    printf("pack bytes for this build: %zd\n", kSimdPackBytes);
+    run<float, 3>("float");
+    run<float, 8>("float");
+    run<float, 16>("float");
+    run<float, 64>("float");
+    run<double, 3>("double");
+    run<double, 12>("double");
+    run<double, 64>("double");
+    return 0;
+}
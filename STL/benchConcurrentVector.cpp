@@ -0,0 +1,53 @@
+#include "Bench.hpp"
+#include "ConcurrentVector.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr std::size_t kTotal = 4'000'000;
+
+template<typename Push>
+double runThreads(std::size_t threads, Push push)
+{
+    return measureMs([&] {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t != threads; t++)
+        {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = t; i < kTotal; i += threads)
+                    push(static_cast<std::uint64_t>(i));
+            });
+        }
+        for (auto &w: workers)
+            w.join();
+    });
+}
+
+int main()
+{
+    printf("%zd appends total, %u hardware threads\n",
+           kTotal,
+           std::thread::hardware_concurrency());
+    printf("%8s %20s %20s\n", "threads", "mutex+Vector ms", "ConcurrentVector ms");
+
+    for (std::size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        std::mutex mutex;
+        Vector<std::uint64_t> locked;
+        double lockedMs = runThreads(threads, [&](std::uint64_t v) {
+            std::lock_guard lock(mutex);
+            locked.push_back(v);
+        });
+
+        ConcurrentVector<std::uint64_t> concurrent;
+        double concurrentMs =
+                runThreads(threads, [&](std::uint64_t v) { concurrent.push_back(v); });
+
+        printf("%8zd %20.3f %20.3f\n", threads, lockedMs, concurrentMs);
+    }
+    return 0;
+}
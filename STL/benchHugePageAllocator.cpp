@@ -0,0 +1,51 @@
+#include "Bench.hpp"
+#include "HugePageAllocator.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+constexpr std::size_t kGB      = 1024 * 1024 * 1024;
+constexpr std::size_t kLookups = 5'000'000;
+
+// Random reads over a table of sizeGB; each index depends on the previous value so
+// the loads cannot overlap and the TLB miss cost is fully exposed.
+template<typename Alloc>
+void run(const char *label, std::size_t sizeGB)
+{
+    std::size_t n = sizeGB * kGB / sizeof(std::uint64_t);
+    Vector<std::uint64_t, Alloc> table(n, default_init);
+    for (std::size_t i = 0; i != n; i++)
+        table[i] = i * 0x9e3779b97f4a7c15ull;
+
+    std::uint64_t x = 1;
+    double ms       = measureMs([&] {
+        for (std::size_t i = 0; i != kLookups; i++)
+            x = table[(x ^ (x >> 29)) % n] + i;
+    });
+    doNotOptimize(x);
+
+    report(label, ms);
+    printf("%-40s %10.1f MB\n",
+           "    advised MADV_HUGEPAGE",
+           hugePageStats().advisedBytes.load() / 1e6);
+    printf("%-40s %10.1f MB\n",
+           "    resident on huge pages",
+           HugePageStats::residentHugeBytes() / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    // the largest table must fit in memory, so pass a smaller limit (in GB) if needed
+    std::size_t maxGB = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8;
+
+    for (std::size_t gb = 1; gb <= maxGB; gb *= 2)
+    {
+        printf("%zd GB table, %zd dependent random reads\n", gb, kLookups);
+        run<std::allocator<std::uint64_t>>("  std::allocator", gb);
+        run<HugePageAllocator<std::uint64_t>>("  HugePageAllocator", gb);
+    }
+    return 0;
+}
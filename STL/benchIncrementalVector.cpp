@@ -0,0 +1,56 @@
+#include "Bench.hpp"
+#include "IncrementalVector.hpp"
+#include "Vector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// per-append latency: Vector stalls for a full copy at every doubling, the incremental
+// mode spreads that copy over the following appends
+
+struct Payload
+{
+    std::uint64_t words[8];
+};
+
+template<typename V>
+void latencyRun(const char *name, std::size_t n)
+{
+    Vector<std::uint32_t> nanos(n, default_init);
+    V v;
+    double total = measureMs([&] {
+        for (std::size_t i = 0; i != n; i++)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            v.push_back(Payload {{i}});
+            auto t1 = std::chrono::steady_clock::now();
+            auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+            nanos[i] = static_cast<std::uint32_t>(ns.count());
+        }
+    });
+    doNotOptimize(v[n / 2]);
+
+    std::sort(nanos.begin(), nanos.end());
+    auto pct = [&](double p) {
+        return nanos[std::min(n - 1, static_cast<std::size_t>(p * n))] / 1000.0;
+    };
+    report(name, total);
+    printf("    p50 %.3f us  p99.9 %.3f us  p99.99 %.3f us  max %.3f us\n",
+           pct(0.5),
+           pct(0.999),
+           pct(0.9999),
+           nanos[n - 1] / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8'000'000;
+    printf("%zd appends of %zd-byte elements\n", n, sizeof(Payload));
+
+    latencyRun<Vector<Payload>>("Vector push_back", n);
+    latencyRun<IncrementalVector<Payload>>("IncrementalVector push_back", n);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "Bench.hpp"
+#include "IndexList.hpp"
+#include "List.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+
+constexpr int kPasses = 5;
+
+/// Bytes the heap holds for the program, mmapped blocks included.
+std::size_t heapBytes()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+template<typename L>
+void run(const char *name, std::size_t n, bool reserve = false)
+{
+    char label[80];
+    std::size_t before = heapBytes();
+    L *l               = nullptr;
+
+    snprintf(label, sizeof(label), "%s: build", name);
+    report(label, measureMs([&] {
+               l = new L;
+               if constexpr (requires { l->reserve(n); })
+                   if (reserve)
+                       l->reserve(n);
+               for (std::size_t i = 0; i != n; i++)
+                   l->push_back(static_cast<std::uint32_t>(i));
+           }));
+
+    std::size_t bytes = heapBytes() - before;
+    printf("%-40s %10.2f bytes/element (%zd MB)\n",
+           "  footprint",
+           static_cast<double>(bytes) / static_cast<double>(n),
+           bytes >> 20);
+
+    snprintf(label, sizeof(label), "%s: traverse", name);
+    report(label, measureMs([&] {
+               std::uint64_t sum = 0;
+               for (int p = 0; p < kPasses; p++)
+                   for (std::uint32_t v: *l)
+                       sum += v;
+               doNotOptimize(sum);
+           }));
+
+    snprintf(label, sizeof(label), "%s: destroy", name);
+    report(label, measureMs([&] { delete l; }));
+}
+
+int main(int argc, char **argv)
+{
+    // e.g. benchIndexList 10000000 100000000; List needs ~3.2GB at 100M
+    for (int a = 1; a < (argc > 1 ? argc : 2); a++)
+    {
+        std::size_t n = argc > 1 ? std::strtoull(argv[a], nullptr, 10) : 10'000'000;
+        printf("%zd uint32_t elements, %d passes per traversal\n", n, kPasses);
+        run<List<std::uint32_t>>("List", n);
+        run<IndexList<std::uint32_t>>("IndexList", n);
+        run<IndexList<std::uint32_t>>("IndexList, reserved", n, true);
+    }
+    return 0;
+}
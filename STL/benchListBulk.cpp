@@ -0,0 +1,63 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+constexpr int kRounds = 5;
+
+template<typename L, typename Build>
+void run(const char *name, const Vector<long> &src, Build build)
+{
+    char label[64];
+    double buildMs = 0, traverseMs = 0, destroyMs = 0;
+    for (int r = 0; r < kRounds; r++)
+    {
+        L *l = nullptr;
+        buildMs += measureMs([&] { l = build(src); });
+        traverseMs += measureMs([&] {
+            long sum = 0;
+            for (long v: *l)
+                sum += v;
+            doNotOptimize(sum);
+        });
+        destroyMs += measureMs([&] { delete l; });
+    }
+
+    snprintf(label, sizeof(label), "%s: build", name);
+    report(label, buildMs / kRounds);
+    snprintf(label, sizeof(label), "%s: traverse", name);
+    report(label, traverseMs / kRounds);
+    snprintf(label, sizeof(label), "%s: destroy", name);
+    report(label, destroyMs / kRounds);
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    Vector<long> src;
+    for (std::size_t i = 0; i != n; i++)
+        src.push_back(static_cast<long>(i));
+    printf("building lists of %zd longs from a Vector, mean of %d rounds\n", n, kRounds);
+
+    run<std::list<long>>("std::list(first, last)", src, [](const Vector<long> &v) {
+        return new std::list<long>(v.begin(), v.end());
+    });
+    run<List<long>>("List push_back per element", src, [](const Vector<long> &v) {
+        auto *l = new List<long>;
+        for (long x: v)
+            l->push_back(x);
+        return l;
+    });
+    run<List<long>>("List(first, last)", src, [](const Vector<long> &v) {
+        return new List<long>(v.begin(), v.end());
+    });
+    run<List<long>>("List::insert(pos, first, last)", src, [](const Vector<long> &v) {
+        auto *l = new List<long> {-1, -2};
+        l->insert(std::next(l->begin()), v.begin(), v.end());
+        return l;
+    });
+    return 0;
+}
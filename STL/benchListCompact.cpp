@@ -0,0 +1,63 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+constexpr int kPasses = 10;
+
+long traverse(const List<long> &l)
+{
+    long sum = 0;
+    for (int p = 0; p < kPasses; p++)
+        for (long v: l)
+            sum += v;
+    return sum;
+}
+
+/// Erase random elements and insert replacements at other random places, which is
+/// what leaves a long-lived list's nodes scattered over the heap.
+void churn(List<long> &l, std::size_t steps)
+{
+    Vector<List<long>::iterator> its;
+    for (auto it = l.begin(); it != l.end(); ++it)
+        its.push_back(it);
+
+    std::mt19937_64 rng(7);
+    for (std::size_t s = 0; s != steps; s++)
+    {
+        std::size_t i = rng() % its.size(), j = rng() % its.size();
+        if (i == j)
+            continue;
+        l.erase(its[i]);
+        its[i] = l.insert(its[j], static_cast<long>(s));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    printf("%zd elements, %d passes per traversal\n", n, kPasses);
+
+    List<long> l;
+    for (std::size_t i = 0; i != n; i++)
+        l.push_back(static_cast<long>(i));
+    report("traverse fresh", measureMs([&] { doNotOptimize(traverse(l)); }));
+
+    report("churn (4n erase + insert)", measureMs([&] { churn(l, 4 * n); }));
+    report("traverse fragmented", measureMs([&] { doNotOptimize(traverse(l)); }));
+
+    report("compact()", measureMs([&] { l.compact(); }));
+    report("traverse compacted", measureMs([&] { doNotOptimize(traverse(l)); }));
+
+    churn(l, 4 * n);
+    report("traverse fragmented again", measureMs([&] { doNotOptimize(traverse(l)); }));
+    report("compact(it, 4096) steps", measureMs([&] {
+               for (auto it = l.begin(); it != l.end();)
+                   it = l.compact(it, 4096);
+           }));
+    report("traverse compacted in steps", measureMs([&] { doNotOptimize(traverse(l)); }));
+    return 0;
+}
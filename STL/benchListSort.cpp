@@ -0,0 +1,50 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "Vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+
+template<typename L>
+L randomList(std::size_t n)
+{
+    std::mt19937 rng(42);
+    L l;
+    for (std::size_t i = 0; i != n; i++)
+        l.push_back(static_cast<int>(rng()));
+    return l;
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    printf("sorting %zd random ints\n", n);
+
+    {
+        auto l = randomList<List<int>>(n);
+        report("List::sort (relinking merge sort)", measureMs([&] { l.sort(); }));
+        doNotOptimize(l.front());
+    }
+    {
+        auto l = randomList<std::list<int>>(n);
+        report("std::list::sort", measureMs([&] { l.sort(); }));
+        doNotOptimize(l.front());
+    }
+    {
+        // the usual workaround: copy out, sort contiguously, write back
+        auto l = randomList<List<int>>(n);
+        report("List -> Vector, std::sort, write back", measureMs([&] {
+                   Vector<int> v;
+                   v.reserve(l.size());
+                   for (auto it = l.cbegin(); it != l.cend(); ++it)
+                       v.push_back(*it);
+                   std::sort(v.begin(), v.end());
+                   std::copy(v.begin(), v.end(), l.begin());
+               }));
+        doNotOptimize(l.front());
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "LruCache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr std::size_t kEntries = 100'000;
+constexpr std::size_t kLookups = 10'000'000;
+
+/// The hand-rolled cache this replaces: recency in a List, lookup through a map of
+/// iterators, two allocations per entry.
+struct ListMapLru
+{
+    using Entry = std::pair<std::uint64_t, std::uint64_t>;
+
+    explicit ListMapLru(std::size_t capacity) : mCapacity(capacity) { }
+
+    std::uint64_t *get(std::uint64_t key)
+    {
+        auto it = mIndex.find(key);
+        if (it == mIndex.end())
+            return nullptr;
+        mOrder.splice(mOrder.end(), mOrder, it->second);
+        return &(*it->second).second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value)
+    {
+        if (std::uint64_t *hit = get(key))
+        {
+            *hit = value;
+            return;
+        }
+        if (mOrder.size() == mCapacity)
+        {
+            mIndex.erase(mOrder.front().first);
+            mOrder.pop_front();
+        }
+        mOrder.emplace_back(key, value);
+        mIndex.emplace(key, std::prev(mOrder.end()));
+    }
+
+  private:
+    std::size_t mCapacity;
+    List<Entry> mOrder;
+    std::unordered_map<std::uint64_t, List<Entry>::iterator> mIndex;
+};
+
+template<typename Cache>
+void run(const char *name,
+         const std::vector<std::uint64_t> &hits,
+         const std::vector<std::uint64_t> &churn)
+{
+    char label[64];
+    Cache cache(kEntries);
+    for (std::size_t i = 0; i != kEntries; i++)
+        cache.put(i, i);
+
+    double ms = measureMs([&] {
+        std::uint64_t sum = 0;
+        for (std::uint64_t key: hits)
+            sum += *cache.get(key);
+        doNotOptimize(sum);
+    });
+    snprintf(label, sizeof(label), "%s: hit (%.1f ns each)", name, ms * 1e6 / kLookups);
+    report(label, ms);
+
+    ms = measureMs([&] {
+        std::uint64_t sum = 0;
+        for (std::uint64_t key: churn)
+        {
+            if (std::uint64_t *v = cache.get(key))
+                sum += *v;
+            else
+                cache.put(key, key);
+        }
+        doNotOptimize(sum);
+    });
+    snprintf(label, sizeof(label), "%s: get or put", name);
+    report(label, ms);
+}
+
+int main()
+{
+    // hits over the whole cache; then a key space twice its size, so half miss
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> hits(kLookups), churn(kLookups);
+    for (auto &key: hits)
+        key = rng() % kEntries;
+    for (auto &key: churn)
+        key = rng() % (2 * kEntries);
+
+    run<ListMapLru>("List+unordered_map", hits, churn);
+    run<LruCache<std::uint64_t, std::uint64_t>>("LruCache", hits, churn);
+    run<LfuCache<std::uint64_t, std::uint64_t>>("LfuCache", hits, churn);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "MemoryResource.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+// a "request" builds a few short-lived containers and throws them away
+
+constexpr int kRequests = 200'000;
+
+template<typename Alloc>
+long handleRequest(int r, const Alloc &alloc)
+{
+    Vector<int, Alloc> ids(alloc);
+    using LongAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<long>;
+    List<long, LongAlloc> log(alloc);
+    for (int i = 0; i < 64; i++)
+    {
+        ids.push_back(r + i);
+        log.push_back(r * i);
+    }
+    return ids.back() + log.back();
+}
+
+long withStd()
+{
+    long sum = 0;
+    for (int r = 0; r < kRequests; r++)
+        sum += handleRequest(r, std::allocator<int> {});
+    return sum;
+}
+
+long withArena()
+{
+    // a request fits in the buffer, so release() never goes back to malloc
+    std::byte buffer[16 * 1024];
+    MonotonicArena arena(buffer, sizeof(buffer));
+    long sum = 0;
+    for (int r = 0; r < kRequests; r++)
+    {
+        sum += handleRequest(r, PolymorphicAllocator<int>(&arena));
+        arena.release();
+    }
+    return sum;
+}
+
+long withResource(MemoryResource &resource)
+{
+    long sum = 0;
+    for (int r = 0; r < kRequests; r++)
+        sum += handleRequest(r, PolymorphicAllocator<int>(&resource));
+    return sum;
+}
+
+template<typename F>
+void threaded(const char *name, int threads, F &&fn)
+{
+    report(name, measureMs([&] {
+               std::thread pool[8];
+               for (int t = 0; t < threads; t++)
+                   pool[t] = std::thread([&] { doNotOptimize(fn()); });
+               for (int t = 0; t < threads; t++)
+                   pool[t].join();
+           }));
+}
+
+int main()
+{
+    printf("%d requests per thread\n", kRequests);
+
+    report("std::allocator", measureMs([] { doNotOptimize(withStd()); }));
+    report("MonotonicArena, release per request",
+           measureMs([] { doNotOptimize(withArena()); }));
+    PoolResource pool;
+    report("PoolResource", measureMs([&] { doNotOptimize(withResource(pool)); }));
+    ThreadCachingResource cached;
+    report("ThreadCachingResource", measureMs([&] {
+               doNotOptimize(withResource(cached));
+           }));
+
+    threaded("std::allocator, 4 threads", 4, withStd);
+    threaded("MonotonicArena, 4 threads", 4, withArena);
+    threaded("ThreadCachingResource, 4 threads", 4, [&] {
+        return withResource(cached);
+    });
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "Bench.hpp"
+#include "MmapAllocator.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+constexpr std::size_t kMB = 1024 * 1024;
+
+// Grow a byte vector from 1MB to maxMB in 1MB appends, filling each chunk, and
+// report the time spent inside reallocations as seen by the observer.
+template<typename Alloc>
+void run(const char *label, std::size_t maxMB)
+{
+    ReallocStats stats;
+    Vector<unsigned char, Alloc, DoublingGrowth, ReallocRecorder> v;
+    v.observer().stats = &stats;
+
+    double ms = measureMs([&] {
+        for (std::size_t i = 0; i != maxMB; i++)
+            std::memset(v.append_for_overwrite(kMB).data(), static_cast<int>(i), kMB);
+        doNotOptimize(v.data());
+    });
+
+    printf("%s\n", label);
+    report("  total", ms);
+    report("  inside reallocations", stats.totalNanos.load() / 1e6);
+    report("  worst single stall", stats.maxNanos.load() / 1e6);
+    printf("%-40s %10.1f MB\n", "  live bytes carried over", stats.bytesMoved.load() / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    // the copying path briefly holds 1.5x the final size, so pass a smaller limit
+    // (in MB) on machines without ~6GB of free memory
+    std::size_t maxMB = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+
+    run<std::allocator<unsigned char>>("std::allocator (allocate + copy)", maxMB);
+    run<MmapAllocator<unsigned char>>("MmapAllocator (mremap)", maxMB);
+    return 0;
+}
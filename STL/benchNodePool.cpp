@@ -0,0 +1,52 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "NodePool.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <list>
+
+// queue-like churn: a window of kWindow elements, each step appends one and drops one
+
+constexpr std::size_t kWindow = 10'000;
+constexpr std::size_t kSteps  = 20'000'000;
+
+template<typename L>
+long churn()
+{
+    L q;
+    for (std::size_t i = 0; i != kWindow; i++)
+        q.push_back(static_cast<long>(i));
+    long sum = 0;
+    for (std::size_t i = 0; i != kSteps; i++)
+    {
+        q.push_back(static_cast<long>(i));
+        sum += q.front();
+        q.pop_front();
+    }
+    return sum;
+}
+
+int main()
+{
+    printf("window %zd, %zd push_back/pop_front steps\n", kWindow, kSteps);
+
+    report("std::list<long>", measureMs([] { doNotOptimize(churn<std::list<long>>()); }));
+    report("List<long>", measureMs([] { doNotOptimize(churn<List<long>>()); }));
+    report("List<long, NodePoolAllocator>", measureMs([] {
+               doNotOptimize(churn<List<long, NodePoolAllocator<long>>>());
+           }));
+
+    // grow, drop everything, give the memory back
+    List<long, NodePoolAllocator<long>> big;
+    for (long i = 0; i < 4'000'000; i++)
+        big.push_back(i);
+    auto pool = big.get_allocator().pool();
+    big.clear();
+    std::size_t slabs    = pool->slabCount();
+    std::size_t released = 0;
+    report("NodePool::shrink after 4M nodes", measureMs([&] {
+               released = pool->shrink();
+           }));
+    printf("    %zd slabs, %zd MB released\n", slabs, released >> 20);
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "Bench.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+struct Record
+{
+    std::uint64_t id;
+    double values[7];
+};
+
+int main(int argc, char **argv)
+{
+    // snapshot size in MB; the default needs ~1.5GB of free memory
+    std::size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+    std::size_t n  = mb * 1024 * 1024 / sizeof(Record);
+    printf("%zd MB of %zd-byte records, %zd pool workers\n",
+           mb,
+           sizeof(Record),
+           ThreadPool::global().size());
+
+    Record proto {42, {1, 2, 3, 4, 5, 6, 7}};
+
+    report("Vector(n, value)", measureMs([&] {
+               Vector<Record> v(n, proto);
+               doNotOptimize(v.data());
+           }));
+    report("Vector(par, n, value)", measureMs([&] {
+               Vector<Record> v(par, n, proto);
+               doNotOptimize(v.data());
+           }));
+
+    Vector<Record> snapshot(par, n, proto);
+    report("Vector(const Vector &)", measureMs([&] {
+               Vector<Record> copy(snapshot);
+               doNotOptimize(copy.data());
+           }));
+    report("Vector(par, const Vector &)", measureMs([&] {
+               Vector<Record> copy(par, snapshot);
+               doNotOptimize(copy.data());
+           }));
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "MpmcQueue.hpp"
+#include "MpscQueue.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Producers push total items between them while one consumer drains them with
+/// drain(fn), which returns how many it handed to fn.
+template<typename Push, typename Drain>
+double runQueue(std::size_t producers, std::size_t total, Push push, Drain drain)
+{
+    return measureMs([&] {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t != producers; t++)
+        {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = t; i < total; i += producers)
+                    push(static_cast<std::uint64_t>(i));
+            });
+        }
+
+        std::uint64_t sum = 0;
+        for (std::size_t received = 0; received != total;)
+        {
+            std::size_t n = drain([&](std::uint64_t v) { sum += v; });
+            if (n == 0)
+                std::this_thread::yield();
+            received += n;
+        }
+        doNotOptimize(sum);
+
+        for (auto &t: threads)
+            t.join();
+    });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    printf("%zd items, one consumer, %u hardware threads\n",
+           total,
+           std::thread::hardware_concurrency());
+    printf("%10s %18s %18s %18s\n",
+           "producers",
+           "mutex+List ms",
+           "MpscQueue ms",
+           "MpmcQueue ms");
+
+    for (std::size_t producers = 1; producers <= 32; producers *= 2)
+    {
+        // the baseline consumer takes the whole list in one splice per lock
+        std::mutex mutex;
+        List<std::uint64_t> shared;
+        double lockedMs = runQueue(
+                producers,
+                total,
+                [&](std::uint64_t v) {
+                    std::lock_guard lock(mutex);
+                    shared.push_back(v);
+                },
+                [&](auto &&fn) {
+                    List<std::uint64_t> batch;
+                    {
+                        std::lock_guard lock(mutex);
+                        batch.splice(batch.end(), shared);
+                    }
+                    for (std::uint64_t v: batch)
+                        fn(v);
+                    return batch.size();
+                });
+
+        MpscQueue<std::uint64_t> mpsc;
+        double mpscMs = runQueue(
+                producers,
+                total,
+                [&](std::uint64_t v) { mpsc.push(v); },
+                [&](auto &&fn) { return mpsc.consume(fn, 1024); });
+
+        MpmcQueue<std::uint64_t> mpmc(4096);
+        double mpmcMs = runQueue(
+                producers,
+                total,
+                [&](std::uint64_t v) {
+                    while (!mpmc.try_push(v))
+                        std::this_thread::yield();
+                },
+                [&](auto &&fn) { return mpmc.consume(fn, 1024); });
+
+        printf("%10zd %18.3f %18.3f %18.3f\n", producers, lockedMs, mpscMs, mpmcMs);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "Bench.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <span>
+
+constexpr std::size_t kBytes = 100 * 1024 * 1024;
+
+// Simulate the read/decode step that overwrites the whole buffer anyway.
+void overwrite(std::span<unsigned char> buf)
+{
+    std::memset(buf.data(), 0xab, buf.size());
+    doNotOptimize(buf.data());
+}
+
+int main()
+{
+    report("Vector(n) + overwrite", measureMs([] {
+               Vector<unsigned char> buf(kBytes);
+               overwrite(buf);
+           }));
+
+    report("Vector(n, default_init) + overwrite", measureMs([] {
+               Vector<unsigned char> buf(kBytes, default_init);
+               overwrite(buf);
+           }));
+
+    Vector<unsigned char> a, b;
+    a.reserve(kBytes);
+    b.reserve(kBytes);
+    overwrite({a.data(), kBytes});   // fault the pages in, so only the fill is timed
+    overwrite({b.data(), kBytes});
+
+    report("resize(n) + overwrite", measureMs([&] {
+               a.resize(kBytes);
+               overwrite(a);
+           }));
+
+    report("resize_for_overwrite(n) + overwrite", measureMs([&] {
+               b.resize_for_overwrite(kBytes);
+               overwrite(b);
+           }));
+
+    a.clear();
+    b.clear();
+    report("resize(size + 1MB) x100", measureMs([&] {
+               for (int i = 0; i < 100; i++)
+               {
+                   std::size_t old = a.size();
+                   a.resize(old + kBytes / 100);
+                   overwrite({a.data() + old, kBytes / 100});
+               }
+           }));
+
+    report("append_for_overwrite(1MB) x100", measureMs([&] {
+               for (int i = 0; i < 100; i++)
+                   overwrite(b.append_for_overwrite(kBytes / 100));
+           }));
+    return 0;
+}
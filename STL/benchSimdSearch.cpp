@@ -0,0 +1,58 @@
+#include "Bench.hpp"
+#include "Vector.hpp"
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+constexpr std::size_t kElements = 64 * 1024 * 1024;   // 256MB of uint32_t
+constexpr int kRepeats          = 5;
+
+template<typename F>
+double best(F &&fn)
+{
+    double ms = measureMs(fn);
+    for (int i = 1; i < kRepeats; i++)
+        ms = std::min(ms, measureMs(fn));
+    return ms;
+}
+
+int main()
+{
+    const char *levels[] = {"scalar", "SSE4.2", "AVX2"};
+    printf("kernel level: %s\n", levels[static_cast<int>(simdLevel())]);
+
+    Vector<std::uint32_t> a(kElements, default_init);
+    for (std::size_t i = 0; i != kElements; i++)
+        a[i] = static_cast<std::uint32_t>(i * 2654435761u) >> 8;
+    Vector<std::uint32_t> b = a;
+    b.back() ^= 1;   // differ only at the very end
+
+    const std::uint32_t absent = 0xffffffffu;
+
+    report("std::find (absent)", best([&] {
+               doNotOptimize(std::find(a.begin(), a.end(), absent));
+           }));
+    report("Vector::find (absent)", best([&] { doNotOptimize(a.find(absent)); }));
+
+    report("std::count", best([&] {
+               doNotOptimize(std::count(a.begin(), a.end(), a[12345]));
+           }));
+    report("Vector::count", best([&] { doNotOptimize(a.count(a[12345])); }));
+
+    report("std::equal", best([&] {
+               doNotOptimize(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+           }));
+    report("Vector::equal", best([&] { doNotOptimize(a.equal(b)); }));
+
+    report("std::lexicographical_compare_three_way", best([&] {
+               auto r = std::lexicographical_compare_three_way(a.begin(),
+                                                               a.end(),
+                                                               b.begin(),
+                                                               b.end());
+               doNotOptimize(r);
+           }));
+    report("Vector::compare", best([&] { doNotOptimize(a.compare(b)); }));
+    return 0;
+}
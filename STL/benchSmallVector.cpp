@@ -0,0 +1,58 @@
+#include "Bench.hpp"
+#include "SmallVector.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+
+static std::size_t allocations = 0;
+
+template<typename T>
+struct CountingAllocator : std::allocator<T>
+{
+    template<typename U>
+    struct rebind
+    {
+        using other = CountingAllocator<U>;
+    };
+
+    CountingAllocator() = default;
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &) noexcept
+    { }
+
+    T *allocate(std::size_t n)
+    {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+constexpr std::size_t kRequests = 1'000'000;
+
+// Build and drop one short vector per "request", 1..16 elements each.
+template<typename Vec>
+void run(const char *label)
+{
+    allocations = 0;
+    double ms   = measureMs([&] {
+        for (std::size_t r = 0; r != kRequests; r++)
+        {
+            Vec v;
+            std::size_t n = 1 + r % 16;
+            for (std::size_t i = 0; i != n; i++)
+                v.push_back(static_cast<int>(i));
+            doNotOptimize(v.data());
+        }
+    });
+    report(label, ms);
+    printf("%-40s %10zd\n", "  allocations", allocations);
+}
+
+int main()
+{
+    run<Vector<int, CountingAllocator<int>>>("Vector<int>");
+    run<SmallVector<int, 16, CountingAllocator<int>>>("SmallVector<int, 16>");
+    return 0;
+}
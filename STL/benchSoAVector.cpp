@@ -0,0 +1,79 @@
+#include "Bench.hpp"
+#include "SoAVector.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <tuple>
+
+struct Particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    double mass;
+    std::uint64_t id;
+    std::uint64_t flags[4];
+};
+
+constexpr std::size_t kParticles = 4'000'000;
+constexpr int kPasses            = 10;
+
+int main()
+{
+    printf("%zd particles of %zd bytes, %d passes\n",
+           kParticles,
+           sizeof(Particle),
+           kPasses);
+
+    Vector<Particle> aos;
+    SoAVector<float, float, float, float, float, float, double, std::uint64_t> soa;
+    for (std::size_t i = 0; i != kParticles; i++)
+    {
+        float f = static_cast<float>(i % 1000);
+        aos.push_back(Particle {f, f, f, 1, 1, 1, 2.0, i, {}});
+        soa.emplace_back(f, f, f, 1.0f, 1.0f, 1.0f, 2.0, std::uint64_t(i));
+    }
+
+    report("Vector<Particle>: sum of x", measureMs([&] {
+               for (int p = 0; p < kPasses; p++)
+               {
+                   float sum = 0;
+                   for (const Particle &q: aos)
+                       sum += q.x;
+                   doNotOptimize(sum);
+               }
+           }));
+    report("SoAVector: sum of column<0>", measureMs([&] {
+               for (int p = 0; p < kPasses; p++)
+               {
+                   float sum = 0;
+                   for (float x: soa.column<0>())
+                       sum += x;
+                   doNotOptimize(sum);
+               }
+           }));
+
+    report("Vector<Particle>: full-row update", measureMs([&] {
+               for (int p = 0; p < kPasses; p++)
+                   for (Particle &q: aos)
+                   {
+                       q.x += q.vx * static_cast<float>(q.mass);
+                       q.y += q.vy * static_cast<float>(q.mass);
+                       q.z += q.vz * static_cast<float>(q.mass);
+                       q.id += 1;
+                   }
+               doNotOptimize(aos.data());
+           }));
+    report("SoAVector: full-row update via proxy", measureMs([&] {
+               for (int p = 0; p < kPasses; p++)
+                   for (auto [x, y, z, vx, vy, vz, mass, id]: soa)
+                   {
+                       x += vx * static_cast<float>(mass);
+                       y += vy * static_cast<float>(mass);
+                       z += vz * static_cast<float>(mass);
+                       id += 1;
+                   }
+               doNotOptimize(soa.column<0>().data());
+           }));
+    return 0;
+}
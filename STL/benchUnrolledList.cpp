@@ -0,0 +1,56 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "UnrolledList.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+
+constexpr std::size_t kElements = 1'000'000;
+constexpr int kPasses           = 20;
+
+template<typename L>
+long traverse(const L &l)
+{
+    long sum = 0;
+    for (int p = 0; p < kPasses; p++)
+        for (auto it = l.cbegin(); it != l.cend(); ++it)
+            sum += *it;
+    return sum;
+}
+
+/// Insert kElements more values one after another at the middle of l.
+template<typename L>
+void insertMiddle(L &l)
+{
+    auto it = std::next(l.begin(), static_cast<std::ptrdiff_t>(l.size() / 2));
+    for (std::size_t i = 0; i != kElements; i++)
+        it = std::next(l.insert(it, static_cast<long>(i)));
+}
+
+template<typename L>
+void run(const char *name)
+{
+    char label[64];
+    L l;
+    for (std::size_t i = 0; i != kElements; i++)
+        l.push_back(static_cast<long>(i));
+
+    snprintf(label, sizeof(label), "%s: traverse", name);
+    report(label, measureMs([&] { doNotOptimize(traverse(l)); }));
+
+    snprintf(label, sizeof(label), "%s: insert in middle", name);
+    report(label, measureMs([&] { insertMiddle(l); }));
+
+    // List now jumps between the old nodes and the block of new ones
+    snprintf(label, sizeof(label), "%s: traverse after", name);
+    report(label, measureMs([&] { doNotOptimize(traverse(l)); }));
+}
+
+int main()
+{
+    printf("%zd longs, %d traversal passes\n", kElements, kPasses);
+    run<List<long>>("List");
+    run<UnrolledList<long>>("UnrolledList<long, 32>");
+    run<UnrolledList<long, 8>>("UnrolledList<long, 8>");
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "Bench.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <type_traits>
+
+// An owning handle whose relocatability is chosen by the template argument, so both
+// Vector code paths run on the exact same element type and move semantics.
+template<bool Relocatable>
+struct Handle
+{
+    int *p;
+
+    Handle(int v) : p(new int(v)) { }
+
+    Handle(Handle &&that) noexcept : p(that.p) { that.p = nullptr; }
+
+    Handle &operator=(Handle &&that) noexcept
+    {
+        delete p;
+        p      = that.p;
+        that.p = nullptr;
+        return *this;
+    }
+
+    ~Handle() { delete p; }
+};
+
+template<bool Relocatable>
+struct IsTriviallyRelocatable<Handle<Relocatable>> : std::bool_constant<Relocatable>
+{ };
+
+constexpr std::size_t kElements = 1'000'000;
+constexpr std::size_t kInserts  = 200;
+
+template<bool Relocatable>
+void run(const char *label)
+{
+    printf("%s\n", label);
+
+    Vector<Handle<Relocatable>> v;
+    report("  push_back 1M (growth)", measureMs([&] {
+               for (std::size_t i = 0; i != kElements; i++)
+                   v.emplace_back(static_cast<int>(i));
+           }));
+
+    report("  insert at front x200 into 1M", measureMs([&] {
+               for (std::size_t i = 0; i != kInserts; i++)
+                   v.emplace(v.begin(), static_cast<int>(i));
+           }));
+
+    report("  erase at front x200 from 1M", measureMs([&] {
+               for (std::size_t i = 0; i != kInserts; i++)
+                   v.erase(v.begin());
+           }));
+
+    report("  shrink_to_fit 1M", measureMs([&] { v.shrink_to_fit(); }));
+    doNotOptimize(v.data());
+}
+
+int main()
+{
+    run<false>("element-wise move (IsTriviallyRelocatable = false)");
+    run<true>("bulk memcpy/memmove (IsTriviallyRelocatable = true)");
+    return 0;
+}
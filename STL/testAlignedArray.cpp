@@ -0,0 +1,63 @@
+#include "AlignedArray.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+static_assert(std::random_access_iterator<PaddedArray<int, 4>::iterator>);
+static_assert(std::random_access_iterator<PaddedArray<int, 4>::const_iterator>);
+static_assert(sizeof(AlignedArray<int, 4, 64>) == 64);
+static_assert(alignof(AlignedArray<int, 4>) == kCacheLineSize);
+static_assert(sizeof(PaddedArray<int, 4, 128>) == 4 * 128);
+
+constexpr int sumOfSquares()
+{
+    PaddedArray<int, 5> a {};
+    std::iota(a.begin(), a.end(), 1);
+    int s = 0;
+    for (int v: a)
+        s += v * v;
+    return s;
+}
+
+static_assert(sumOfSquares() == 55);
+
+int main()
+{
+    PaddedArray<std::atomic<std::uint64_t>, 8> counters {};
+    for (std::size_t i = 0; i != counters.size(); i++)
+        counters[i].fetch_add(i, std::memory_order_relaxed);
+
+    auto p       = counters.data();
+    auto *first  = reinterpret_cast<const char *>(&p[0]);
+    auto *second = reinterpret_cast<const char *>(&p[1]);
+    printf("stride %zd bytes, measured %td, p[7] = %llu\n",
+           counters.stride(),
+           second - first,
+           static_cast<unsigned long long>(p[7].load()));
+
+    PaddedArray<int, 6, 128> a {5, 3, 9, 1, 7, 3};
+    std::sort(a.begin(), a.end());
+    printf("sorted:");
+    for (auto it = a.crbegin(); it != a.crend(); ++it)
+        printf(" %d", *it);
+    auto lb = std::lower_bound(a.cbegin(), a.cend(), 6);
+    printf("\nlower_bound 6 at %td, back %d, at(2) %d\n",
+           lb - a.begin(),
+           a.back(),
+           a.at(2));
+
+    AlignedArray<int, 6> b {1, 3, 3, 5, 7, 9};
+    printf("unpadded data() is int *: %d, aligned: %d\n",
+           std::is_same_v<decltype(b.data()), int *>,
+           reinterpret_cast<std::uintptr_t>(b.data()) % kCacheLineSize == 0);
+    PaddedArray<int, 6, 128> c = a;
+    c.fill(0);
+    c.swap(a);
+    printf("after fill + swap: a[5] %d, c[5] %d, equal %d\n", a[5], c[5], a == c);
+    return 0;
+}
@@ -38,6 +38,48 @@ void iota(Array<T, N> &a) noexcept
     }
 }
 
+constexpr auto kCrc32Table = make_array_from<256>([](std::size_t i) {
+    std::uint32_t c = static_cast<std::uint32_t>(i);
+    for (int k = 0; k < 8; k++)
+        c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+    return c;
+});
+
+constexpr std::uint32_t crc32(const char *s) noexcept
+{
+    std::uint32_t c = 0xffffffffu;
+    for (; *s; s++)
+        c = kCrc32Table[(c ^ static_cast<std::uint8_t>(*s)) & 0xff] ^ (c >> 8);
+    return c ^ 0xffffffffu;
+}
+
+static_assert(crc32("123456789") == 0xcbf43926u);
+
+constexpr auto kBitReverse = make_array_from<256>([](std::size_t i) {
+    std::uint8_t r = 0;
+    for (int k = 0; k < 8; k++)
+        r |= ((i >> k) & 1) << (7 - k);
+    return r;
+});
+
+static_assert(kBitReverse[0x01] == 0x80 && kBitReverse[0xf0] == 0x0f);
+
+constexpr Array<int, 6> sorted()
+{
+    Array<int, 6> a {5, 3, 9, 1, 7, 3};
+    a.sort();
+    return a;
+}
+
+constexpr Array<int, 6> kSorted = sorted();
+
+// the SIMD-backed members fall back to <algorithm> during constant evaluation
+static_assert(kSorted == Array {1, 3, 3, 5, 7, 9});
+static_assert(kSorted > Array {1, 3, 3, 5, 7, 8});
+static_assert(*kSorted.lower_bound(4) == 5 && kSorted.count(3) == 2);
+static_assert(kSorted.find(7) - kSorted.begin() == 4 && !kSorted.contains(2));
+static_assert(*kSorted.rbegin() == 9 && kSorted.mismatch(kSorted).first == kSorted.end());
+
 int main()
 {
     auto a = Array {2, 1, 0};
@@ -46,5 +88,15 @@ int main()
     for (auto &ai: a) { std::cout << ai << '\n'; }
     std::cout << "front: " << a.front() << '\n';
     std::cout << "back: " << a.back() << '\n';
+    std::cout << "contains 1: " << a.contains(1) << '\n';
+    std::cout << "a == {0, 1, 2}: " << (a == Array {0, 1, 2}) << '\n';
+    std::cout << "a < {0, 2, 0}: " << (a < Array {0, 2, 0}) << '\n';
+
+    Array<int, 5> g;
+    g.generate([n = 10]() mutable { return n--; });
+    g.sort();
+    for (auto it = g.rbegin(); it != g.rend(); ++it) { std::cout << *it << ' '; }
+    std::cout << "\nlower_bound 8: " << *g.lower_bound(8) << '\n';
+    std::cout << "crc32(\"123456789\"): " << std::hex << crc32("123456789") << '\n';
     return 0;
 }
@@ -0,0 +1,76 @@
+#include "ArrayExpr.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+
+// scalars that would narrow into the element type are rejected, not truncated
+template<typename A, typename S>
+concept Scalable = requires(const A &a, S s) { a * s; };
+
+static_assert(Scalable<Array<int, 8>, int> && Scalable<Array<float, 8>, int>);
+static_assert(!Scalable<Array<int, 8>, double> && !Scalable<Array<float, 8>, double>);
+
+/// Check the fused expressions against plain loops at one size; every value is a
+/// small integer, so float sums come out exact in any order.
+template<typename T, std::size_t N>
+bool check()
+{
+    Array<T, N> a, b, c;
+    for (std::size_t i = 0; i != N; i++)
+    {
+        a[i] = static_cast<T>(i % 7) - 3;
+        b[i] = static_cast<T>(i % 5) + 1;
+        c[i] = static_cast<T>(i % 3);
+    }
+
+    Array<T, N> r = fma(a, b, c) - a / 2 + elementwiseMax(a, c) * -b;
+    bool ok       = true;
+    T s = 0, d = 0, lo = a[0], hi = a[0];
+    for (std::size_t i = 0; i != N; i++)
+    {
+        T want = a[i] * b[i] + c[i] - a[i] / 2 + std::max(a[i], c[i]) * -b[i];
+        ok     = ok && r[i] == want;
+        s += a[i];
+        d += a[i] * b[i];
+        lo = std::min(lo, a[i]);
+        hi = std::max(hi, a[i]);
+    }
+    ok = ok && sum(a) == s && dot(a, b) == d && minValue(a) == lo && maxValue(a) == hi;
+    ok = ok && norm(b) == std::sqrt(dot(b, b)) && sum(a + 1) == s + T(N);
+
+    Array<T, N> before = a;
+    c                  = c * b + a;   // assigned in place
+    for (std::size_t i = 0; i != N; i++)
+        ok = ok && c[i] == static_cast<T>(i % 3) * b[i] + a[i];
+
+    a += a * b;   // reads what it writes
+    a -= 1;
+    for (std::size_t i = 0; i != N; i++)
+        ok = ok && a[i] == before[i] + before[i] * b[i] - 1;
+
+    a.swap(b);
+    ok = ok && b[N - 1] == before[N - 1] + before[N - 1] * a[N - 1] - 1;
+    a.fill(a[N - 1]);   // the value lives in the Array it fills
+    ok = ok && minValue(a) == maxValue(a);
+    return ok;
+}
+
+int main()
+{
+    printf("pack bytes for this build: %zd\n", kSimdPackBytes);
+
+    bool ok = check<float, 3>() && check<float, 4>() && check<float, 7>() &&
+              check<float, 16>() && check<float, 29>() && check<float, 64>() &&
+              check<double, 3>() && check<double, 5>() && check<double, 24>() &&
+              check<double, 63>() && check<int, 13>() && check<long, 40>();
+    printf("float/double/int at sizes 3..64: %s\n", ok ? "ok" : "FAILED");
+
+    Array<float, 4> x {1, 2, 3, 4}, y {4, 3, 2, 1};
+    Array<float, 4> z = 2.f * x - y / 2;
+    printf("2x - y/2 = %g %g %g %g\n", z[0], z[1], z[2], z[3]);
+
+    auto lazy = elementwiseMin(x, y);   // an expression, not an Array
+    x[0]      = 10;
+    printf("min after x[0] = 10: %g, dot %g, norm %g\n", lazy[0], dot(x, y), norm(y));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include "ConcurrentVector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int gFailures = 0;   // allocations left to fail
+
+/// std::allocator that throws bad_alloc for the next gFailures allocations.
+template<typename T>
+struct FlakyAllocator : std::allocator<T>
+{
+    using value_type = T;
+
+    FlakyAllocator() = default;
+
+    template<typename U>
+    FlakyAllocator(const FlakyAllocator<U> &) noexcept
+    { }
+
+    template<typename U>
+    struct rebind
+    {
+        using other = FlakyAllocator<U>;
+    };
+
+    T *allocate(std::size_t n)
+    {
+        if (gFailures > 0)
+        {
+            gFailures--;
+            throw std::bad_alloc();
+        }
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+int main()
+{
+    ConcurrentVector<std::string> log;
+    const std::string &first = log.emplace_back("first");
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++)
+    {
+        workers.emplace_back([&log, t] {
+            for (int i = 0; i < 1000; i++)
+                log.push_back("worker " + std::to_string(t) + " item " + std::to_string(i));
+        });
+    }
+
+    // readers may look while writers are still running
+    printf("partial snapshot holds at most %zd\n", log.snapshot().size());
+
+    for (auto &w: workers)
+        w.join();
+
+    std::size_t n = 0;
+    for (const std::string &entry: log.snapshot())
+        n += !entry.empty();
+    printf("log.size() = %zd, snapshot entries = %zd\n", log.size(), n);
+    printf("first is still \"%s\" at the same address: %d\n",
+           first.c_str(),
+           &first == &log[0]);
+
+    // a segment that cannot be allocated becomes tombstones instead of a hole that
+    // would stop every later snapshot short
+    ConcurrentVector<int, FlakyAllocator<int>> flaky;
+    for (int i = 0; i < 10; i++)
+        flaky.push_back(i);
+    gFailures = 2;   // the early install of segment 1, then the append that needs it
+    int failed = 0;
+    for (int i = 10; i < 40; i++)
+    {
+        try
+        {
+            flaky.push_back(i);
+        }
+        catch (const std::bad_alloc &)
+        {
+            failed++;
+        }
+    }
+    std::size_t kept = 0;
+    for (int v: flaky.snapshot())
+        kept += v >= 0;
+    printf("flaky: %d appends failed, %zd of %zd slots visible\n",
+           failed,
+           kept,
+           flaky.size());
+    return 0;
+}
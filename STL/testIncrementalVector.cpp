@@ -0,0 +1,36 @@
+#include "IncrementalVector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+int main()
+{
+    IncrementalVector<std::string> v;
+    for (int i = 0; i < 20; i++)
+    {
+        v.push_back("s" + std::to_string(i));
+        if (v.migrating())
+            printf("push %2d: cap=%zd, still migrating\n", i, v.capacity());
+    }
+
+    // indexing is correct while the elements are split over two buffers
+    for (std::size_t i = 0; i != v.size(); i++)
+        printf("%s ", v[i].c_str());
+    printf("\n");
+
+    for (int i = 0; i < 15; i++)
+        v.pop_back();
+    for (const auto &s: v)
+        printf("%s ", s.c_str());
+    printf("\nsize=%zd cap=%zd migrating=%d\n", v.size(), v.capacity(), v.migrating());
+
+    IncrementalVector<int> ints;
+    for (int i = 0; i < 1000; i++)
+        ints.push_back(i);
+    long sum = 0;
+    for (int x: ints)
+        sum += x;
+    int *p = ints.data();   // contiguous once migration is finished
+    printf("sum=%ld data[999]=%d migrating=%d\n", sum, p[999], ints.migrating());
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "IndexList.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+
+int main()
+{
+    IndexList<std::uint32_t> l {1, 2, 3, 4, 5};
+    auto three = std::next(l.begin(), 2);
+    l.erase(std::next(l.begin()));   // frees node 2
+    l.push_front(0);                 // reuses it
+    printf("capacity %zd after erase + insert of size %zd\n", l.capacity(), l.size());
+
+    for (int i = 0; i < 100; i++)
+        l.push_back(100 + i);   // the arena grows; iterators survive
+    printf("three is still %u\n", *three);
+
+    l.erase(std::next(l.begin(), 5), l.end());
+    for (auto it = l.crbegin(); it != l.crend(); ++it)
+        printf("%u ", *it);
+    printf("\nsize %zd, front %u, back %u\n", l.size(), l.front(), l.back());
+
+    // a value from the list itself is read before the arena grows under it
+    IndexList<std::uint32_t> grow {7};
+    for (int i = 0; i < 10; i++)
+        grow.push_back(grow.front());
+    printf("grown from its front: %zd copies of %u\n", grow.size(), grow.back());
+
+    IndexList<std::uint32_t> copy = l;
+    copy.pop_front();
+    copy.pop_back();
+    printf("copy: ");
+    for (std::uint32_t v: copy)
+        printf("%u ", v);
+    printf("equal: %d\n", copy == l);
+
+    l.clear();
+    printf("cleared: empty %d, capacity kept %d\n", l.empty(), l.capacity() > 100);
+    return 0;
+}
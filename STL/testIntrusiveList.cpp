@@ -0,0 +1,53 @@
+#include "IntrusiveList.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+struct Session
+{
+    int id;
+    std::string user;
+    ListHook<> activeHook;                      // in the active or the idle list
+    ListHook<HookMode::AutoUnlink> timerHook;   // leaves the timer wheel when destroyed
+
+    Session(int id_, std::string user_) : id(id_), user(std::move(user_)) { }
+};
+
+using SessionList = IntrusiveList<Session, &Session::activeHook>;
+using TimerList   = IntrusiveList<Session, &Session::timerHook>;
+
+int main()
+{
+    Session sessions[] = {{1, "ann"}, {2, "bob"}, {3, "cid"}, {4, "dee"}};
+
+    SessionList active, idle;
+    TimerList timers;
+    for (Session &s: sessions)
+    {
+        active.push_back(s);   // no allocation: only the hooks are written
+        timers.push_front(s);
+    }
+
+    active.remove(sessions[1]);   // O(1) from a reference to the object
+    idle.push_back(sessions[1]);
+    idle.splice(idle.cend(), active, active.iterator_to(sessions[3]));
+
+    for (const Session &s: active)
+        printf("active %d %s\n", s.id, s.user.c_str());
+    for (const Session &s: idle)
+        printf("idle %d %s\n", s.id, s.user.c_str());
+
+    {
+        Session temp {5, "eve"};
+        timers.push_back(temp);
+        printf("timers with temp: %zd\n", timers.size());
+    }   // auto-unlinked here
+    printf("timers after temp: %zd\n", timers.size());
+    for (auto it = timers.rbegin(); it != timers.rend(); ++it)
+        printf("timer %d\n", it->id);
+
+    active.clear();
+    idle.clear();
+    printf("linked after clear: %d\n", sessions[0].activeHook.is_linked());
+    return 0;
+}
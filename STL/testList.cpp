@@ -5,9 +5,23 @@
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+/// Counts live instances, so a test can see that no node was lost.
+struct Counted
+{
+    static inline int live = 0;
+    int value;
+
+    explicit Counted(int v) : value(v) { ++live; }
+
+    Counted(const Counted &that) : value(that.value) { ++live; }
+
+    ~Counted() { --live; }
+};
+
 int main()
 {
     List<int> arr {1, 2, 4, 5, 6};
@@ -38,5 +52,89 @@ int main()
     }
 
     printf("arr.size() = %zd\n", arr.size());
+
+    // everything below relinks nodes, nothing is copied
+    arr.sort();
+    List<int> odds {1, 3, 5, 7, 201};
+    arr.merge(odds);
+    arr.push_back(202);
+    printf("removed %zd duplicates\n", arr.unique());
+    arr.reverse();
+    arr2.splice(arr2.cbegin(), arr, std::next(arr.cbegin()), std::prev(arr.cend()));
+    for (auto it = arr.cbegin(); it != arr.cend(); ++it)
+        printf("%d ", *it);
+    printf("| ");
+    for (auto it = arr2.cbegin(); it != arr2.cend(); ++it)
+        printf("%d ", *it);
+    printf("\nsizes %zd %zd\n", arr.size(), arr2.size());
+
+    // compaction moves elements into one block; erasing them still works one by one
+    arr2.compact();
+    for (auto it = arr2.begin(); it != arr2.end();)
+        it = arr2.compact(it, 3);
+    arr2.erase(arr2.begin());
+    arr.splice(arr.cend(), arr2, arr2.cbegin());
+    for (auto it = arr2.cbegin(); it != arr2.cend(); ++it)
+        printf("%d ", *it);
+    printf("\ncompacted sizes %zd %zd\n", arr.size(), arr2.size());
+
+    // splicing an element in front of itself or its successor leaves the list alone
+    List<int> self {1, 2, 3};
+    self.splice(std::next(self.cbegin()), self, std::next(self.cbegin()));
+    self.splice(std::next(self.cbegin(), 2), self, std::next(self.cbegin()));
+    for (auto it = self.cbegin(); it != self.cend(); ++it)
+        printf("%d ", *it);
+    printf("\nself-spliced size %zd\n", self.size());
+
+    // a comparator that throws midway leaves every element in place, linked both ways
+    {
+        List<Counted> shuffled;
+        for (int k = 0; k < 100; k++)
+            shuffled.push_back(Counted {(k * 37) % 100});
+        List<Counted> other;
+        for (int k = 0; k < 50; k++)
+            other.push_back(Counted {k * 2});
+
+        int calls     = 0;
+        auto throwing = [&](const Counted &a, const Counted &b) {
+            if (++calls == 300)
+                throw std::runtime_error("comparator");
+            return a.value < b.value;
+        };
+        bool sortThrew = false, mergeThrew = false;
+        try
+        {
+            shuffled.sort(throwing);
+        }
+        catch (const std::runtime_error &)
+        {
+            sortThrew = true;
+        }
+        calls = 260;
+        try
+        {
+            shuffled.merge(other, throwing);
+        }
+        catch (const std::runtime_error &)
+        {
+            mergeThrew = true;
+        }
+
+        std::size_t forward = 0, backward = 0;
+        for (auto it = shuffled.cbegin(); it != shuffled.cend(); ++it)
+            ++forward;
+        for (auto it = shuffled.crbegin(); it != shuffled.crend(); ++it)
+            ++backward;
+        printf("throwing sort/merge: threw %d %d, sizes %zd + %zd, walked %zd/%zd, "
+               "live %d\n",
+               sortThrew,
+               mergeThrew,
+               shuffled.size(),
+               other.size(),
+               forward,
+               backward,
+               Counted::live);
+    }
+    printf("live after destruction: %d\n", Counted::live);
 }
 
@@ -0,0 +1,53 @@
+#include "LruCache.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+int main()
+{
+    LruCache<int, std::string> lru(3);
+    lru.put(1, "one");
+    lru.put(2, "two");
+    lru.put(3, "three");
+    lru.get(1);           // 2 is now the least recently used
+    lru.put(4, "four");   // evicts 2
+    printf("lru: size = %zd, has 2 = %d, has 1 = %d\n",
+           lru.size(),
+           lru.contains(2),
+           lru.contains(1));
+    lru.for_each([](int key, std::string &value) {
+        printf("  %d -> %s\n", key, value.c_str());
+    });
+
+    lru.put(3, "THREE");   // overwriting counts as a use
+    printf("lru: get(3) = %s, get(9) = %p\n", lru.get(3)->c_str(), (void *)lru.get(9));
+    bool erased = lru.erase(1);
+    printf("lru: erase(1) = %d, size = %zd\n", erased, lru.size());
+
+    LfuCache<int, int> lfu(3);
+    lfu.put(1, 10);
+    lfu.put(2, 20);
+    lfu.put(3, 30);
+    lfu.get(1);
+    lfu.get(1);
+    lfu.get(3);
+    lfu.put(4, 40);   // 2 has been used least: evicted
+    lfu.put(5, 50);   // 4 is now alone at one use
+    printf("lfu: has 2 = %d, has 4 = %d, has 1 = %d, has 3 = %d, has 5 = %d\n",
+           lfu.contains(2),
+           lfu.contains(4),
+           lfu.contains(1),
+           lfu.contains(3),
+           lfu.contains(5));
+
+    // a byte budget: each entry costs its key, value and string buffer
+    LruCache<int, std::string, EntryBytes> bytes(1024);
+    for (int i = 0; i < 100; i++)
+        bytes.put(i, std::string(100, 'x'));
+    printf("bytes: %zd entries weigh %zd of %zd bytes, oldest kept = %d\n",
+           bytes.size(),
+           bytes.weight(),
+           bytes.capacity(),
+           bytes.contains(100 - static_cast<int>(bytes.size())));
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "MappedVector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+struct Record
+{
+    int id;
+    double score;
+};
+
+int main()
+{
+    std::string path = (std::filesystem::temp_directory_path() / "records.mvec").string();
+    std::filesystem::remove(path);
+
+    {
+        MappedVector<Record> records(path);
+        for (int i = 0; i < 10; i++)
+            records.push_back({i, i * 0.5});
+        records.sync();
+        printf("wrote size=%zd cap=%zd\n", records.size(), records.capacity());
+    }
+
+    {   // reopen: no parsing, the elements are simply mapped back in
+        MappedVector<Record> records(path, MapMode::ReadOnly);
+        for (const Record &r: records)
+            printf("records[%d].score = %g\n", r.id, r.score);
+    }
+
+    {   // private edits and growth never reach the file
+        MappedVector<Record> scratch(path, MapMode::CopyOnWrite);
+        scratch[0].score = 100;
+        for (int i = 0; i < 100; i++)
+            scratch.push_back({10 + i, 0});
+        printf("scratch.size() = %zd, scratch[0].score = %g\n",
+               scratch.size(),
+               scratch[0].score);
+    }
+
+    MappedVector<Record> opened(path, MapMode::ReadOnly);
+    MappedVector<Record> records = std::move(opened);
+    printf("file size=%zd, records[0].score = %g, moved-from size=%zd\n",
+           records.size(),
+           records[0].score,
+           opened.size());
+
+    // a header promising more elements than the file holds is refused
+    std::filesystem::resize_file(path, 64 + 3 * sizeof(Record));
+    try
+    {
+        MappedVector<Record> truncated(path, MapMode::ReadOnly);
+        printf("truncated file opened\n");
+    }
+    catch (const std::runtime_error &e)
+    {
+        printf("%s\n", e.what());
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
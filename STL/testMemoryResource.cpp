@@ -0,0 +1,76 @@
+#include "List.hpp"
+#include "MemoryResource.hpp"
+#include "UniquePtr.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+struct Request
+{
+    int id;
+    std::string path;
+
+    Request(int id_, std::string path_) : id(id_), path(std::move(path_)) { }
+
+    ~Request() { printf("~Request(%d)\n", id); }
+};
+
+int main()
+{
+    // per-request arena: everything is released in one go at the end
+    std::byte stack[1024];
+    MonotonicArena arena(stack, sizeof(stack));
+    {
+        Vector<int, PolymorphicAllocator<int>> v(&arena);
+        for (int i = 0; i < 1000; i++)
+            v.push_back(i);
+
+        // List rebinds the allocator to its node type and keeps using the arena
+        List<std::string, PolymorphicAllocator<std::string>> names(&arena);
+        names.push_back("alpha");
+        names.push_back("beta");
+        names.push_front("zero");
+        for (auto it = names.cbegin(); it != names.cend(); ++it)
+            printf("%s ", (*it).c_str());
+        printf("\nv.back() = %d\n", v.back());
+
+        auto req = makeArenaUnique<Request>(arena, 7, "/index.html");
+        printf("request %d %s\n", req->id, req->path.c_str());
+    }
+    arena.release();
+
+    MonotonicArena fresh;   // no buffer and no chunk yet
+    void *empty  = fresh.allocate(0);
+    void *second = fresh.allocate(0);
+    printf("zero-byte allocations: non-null %d, distinct %d\n",
+           empty != nullptr,
+           empty != second);
+
+    PoolResource pool;
+    void *a = pool.allocate(24);
+    pool.deallocate(a, 24);
+    void *b = pool.allocate(32);   // same 32-byte class, same block
+    printf("pool reuses freed block: %d\n", a == b);
+    pool.deallocate(b, 32);
+
+    ThreadCachingResource shared;
+    auto work = [&shared] {
+        List<int, PolymorphicAllocator<int>> l(&shared);
+        for (int i = 0; i < 10000; i++)
+            l.push_back(i);
+        long sum = 0;
+        for (auto it = l.cbegin(); it != l.cend(); ++it)
+            sum += *it;
+        return sum;
+    };
+    long sums[4] = {};
+    std::thread threads[4];
+    for (int t = 0; t < 4; t++)
+        threads[t] = std::thread([&, t] { sums[t] = work(); });
+    for (auto &t: threads)
+        t.join();
+    printf("thread sums: %ld %ld %ld %ld\n", sums[0], sums[1], sums[2], sums[3]);
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "MpmcQueue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    MpmcQueue<int> ring(3);
+    int pushed = 0;
+    while (ring.try_push(pushed))
+        pushed++;
+    int v = -1;
+    ring.try_pop(v);
+    printf("capacity %zd holds %d before full; first out: %d\n",
+           ring.capacity(),
+           pushed,
+           v);
+
+    MpmcQueue<long long> queue(1024);
+    constexpr int kProducers = 4, kConsumers = 3, kEach = 20000;
+    std::atomic<long long> sum {0};
+    std::atomic<int> received {0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kProducers; t++)
+    {
+        threads.emplace_back([&queue, t] {
+            for (long long i = 0; i < kEach; i++)
+                while (!queue.try_push(t * kEach + i))
+                    std::this_thread::yield();
+        });
+    }
+    for (int t = 0; t < kConsumers; t++)
+    {
+        threads.emplace_back([&] {
+            long long local = 0;
+            while (received.load(std::memory_order_relaxed) != kProducers * kEach)
+            {
+                std::size_t n = queue.consume([&](long long x) { local += x; }, 64);
+                received.fetch_add(static_cast<int>(n), std::memory_order_relaxed);
+                if (n == 0)
+                    std::this_thread::yield();
+            }
+            sum += local;
+        });
+    }
+    for (auto &t: threads)
+        t.join();
+
+    long long total = kProducers * kEach;
+    printf("received %d, sum ok: %d\n",
+           received.load(),
+           sum.load() == total * (total - 1) / 2);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "MpscQueue.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Job
+{
+    int id;
+    MpscHook hook;
+};
+
+int main()
+{
+    IntrusiveMpscQueue<Job, &Job::hook> jobs;
+    Job a {1, {}}, b {2, {}}, c {3, {}};
+    jobs.push(a);
+    jobs.push(b);
+    jobs.push(c);
+    Job *batch[4];
+    std::size_t got = jobs.pop_bulk(batch, 4);
+    printf("intrusive: popped %zd: %d %d %d, empty = %d\n",
+           got,
+           batch[0]->id,
+           batch[1]->id,
+           batch[2]->id,
+           jobs.empty());
+
+    // one object left behind a partial drain still counts
+    jobs.push(a);
+    jobs.push(b);
+    Job *oldest    = jobs.pop();
+    bool leftEmpty = jobs.empty();
+    Job *newest    = jobs.pop();
+    printf("partial drain: popped %d, empty = %d, then %d, empty = %d\n",
+           oldest->id,
+           leftEmpty,
+           newest->id,
+           jobs.empty());
+
+    MpscQueue<std::string> queue;
+    constexpr int kProducers = 4, kEach = 10000;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kProducers; t++)
+    {
+        producers.emplace_back([&queue, t] {
+            for (int i = 0; i < kEach; i++)
+                queue.push(std::to_string(t * kEach + i));
+        });
+    }
+
+    // the consumer runs alongside the producers, draining in batches
+    long long sum = 0;
+    int received = 0, batches = 0;
+    while (received != kProducers * kEach)
+    {
+        std::size_t n =
+                queue.consume([&](std::string &&s) { sum += std::stoll(s); }, 256);
+        received += static_cast<int>(n);
+        batches += n != 0;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    for (auto &p: producers)
+        p.join();
+
+    long long total = kProducers * kEach;
+    printf("received %d in %d batches, sum ok: %d, empty = %d\n",
+           received,
+           batches,
+           sum == total * (total - 1) / 2,
+           queue.empty());
+
+    std::string out;
+    queue.push("last");
+    bool first  = queue.try_pop(out);
+    bool second = queue.try_pop(out);
+    printf("try_pop -> %d \"%s\", again -> %d\n", first, out.c_str(), second);
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "List.hpp"
+#include "NodePool.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+int main()
+{
+    // each list gets its own pool on first insertion
+    List<std::string, NodePoolAllocator<std::string>> words;
+    for (int i = 0; i < 5; i++)
+        words.push_back("w" + std::to_string(i));
+    words.pop_front();
+    words.erase(std::next(words.cbegin()));   // the node goes back to the pool
+    words.push_back("reused");
+    for (auto it = words.cbegin(); it != words.cend(); ++it)
+        printf("%s ", (*it).c_str());
+    auto &pool = *words.get_allocator().pool();
+    printf("\nlive=%zd slabs=%zd\n", pool.liveBlocks(), pool.slabCount());
+
+    // lists sharing one pool recycle each other's nodes
+    auto shared = std::make_shared<NodePool>(sizeof(ListValueNode<int>),
+                                             alignof(ListValueNode<int>));
+    NodePoolAllocator<int> alloc(shared);
+    List<int, NodePoolAllocator<int>> a(alloc), b(alloc);
+    for (int i = 0; i < 100000; i++)
+        a.push_back(i);
+    printf("after fill: live=%zd slabs=%zd\n", shared->liveBlocks(), shared->slabCount());
+    a.clear();
+    for (int i = 0; i < 1000; i++)
+        b.push_back(i);
+    printf("b reuses a's nodes: live=%zd slabs=%zd\n",
+           shared->liveBlocks(),
+           shared->slabCount());
+
+    b.insert(b.end(), 500, 7);   // a bulk insert still takes its nodes from the pool
+    printf("after bulk insert: live=%zd\n", shared->liveBlocks());
+
+    std::size_t released = shared->shrink();
+    printf("shrink released %zd KB, slabs=%zd, b.back()=%d\n",
+           released / 1024,
+           shared->slabCount(),
+           b.back());
+    return 0;
+}
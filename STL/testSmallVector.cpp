@@ -0,0 +1,33 @@
+#include "SmallVector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+int main()
+{
+    SmallVector<int, 4> arr;
+    for (int i = 0; i < 4; i++)
+        arr.push_back(i);
+    printf("size=%zd cap=%zd inline=%d\n", arr.size(), arr.capacity(), arr.isInline());
+
+    arr.push_back(4);   // spills to the heap
+    printf("size=%zd cap=%zd inline=%d\n", arr.size(), arr.capacity(), arr.isInline());
+
+    arr.erase(arr.begin(), arr.begin() + 2);
+    arr.shrink_to_fit();   // fits again, moves back inline
+    printf("size=%zd cap=%zd inline=%d\n", arr.size(), arr.capacity(), arr.isInline());
+
+    SmallVector<std::string, 2> a {"inline"};
+    SmallVector<std::string, 2> b {"on", "the", "heap"};
+    a.swap(b);
+    printf("a.size() = %zd, a.isInline() = %d\n", a.size(), a.isInline());
+    printf("b.size() = %zd, b.isInline() = %d\n", b.size(), b.isInline());
+
+    SmallVector<std::string, 2> c = std::move(a);
+    SmallVector<std::string, 2> d = b;
+    for (size_t i = 0; i < c.size(); i++)
+        printf("c[%zd] = %s\n", i, c[i].c_str());
+    printf("d[0] = %s, a.size() = %zd\n", d[0].c_str(), a.size());
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include "SoAVector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <string>
+
+int main()
+{
+    // columns: id, x, name
+    SoAVector<int, float, std::string> rows;
+    for (int i = 0; i < 5; i++)
+        rows.emplace_back(i, i * 1.5f, "row" + std::to_string(i));
+    rows.push_back(99, 0.0f, "last");
+    printf("size=%zd cap=%zd\n", rows.size(), rows.capacity());
+
+    float sum = 0;
+    for (float x: rows.column<1>())   // touches only the x column
+        sum += x;
+    printf("sum of x = %g\n", sum);
+
+    auto [id, x, name] = rows[2];   // proxy of references into each column
+    x                  = 100;
+    name += "!";
+    printf("rows[2] = {%d, %g, %s}\n", id, std::get<1>(rows[2]), name.c_str());
+
+    SoAVector<int, float, std::string> copy = rows;
+    copy.pop_back();
+    for (auto [id, x, name]: copy)
+        printf("{%d, %g, %s}\n", id, x, name.c_str());
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "List.hpp"
+#include "UnrolledList.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+int main()
+{
+    UnrolledList<int, 4> arr {1, 2, 4, 5, 6};
+    printf("arr.size() = %zd, blocks = %zd\n", arr.size(), arr.block_count());
+    arr.erase(arr.cbegin(), std::next(arr.cbegin(), 2));
+    auto mid = arr.insert(std::next(arr.cbegin()), 40);   // splits a full block
+    arr.insert(mid, 41);
+
+    for (int i = 0; i < 3; i++)
+        arr.push_back(100 + i);
+    for (int i = 0; i < 3; i++)
+        arr.push_front(200 + i);
+
+    std::size_t i = 0;
+    for (auto it = arr.cbegin(); it != arr.cend(); ++it)
+        printf("arr[%zd] = %d\n", i++, *it);
+    printf("size = %zd, blocks = %zd\n", arr.size(), arr.block_count());
+
+    for (auto it = arr.crbegin(); it != arr.crend(); ++it)
+        printf("%d ", *it);
+    printf("\n");
+
+    // same iterator interface as List, so generic code takes either
+    List<int> list(arr.begin(), arr.end());
+    printf("equal to List copy: %d\n", std::equal(list.begin(), list.end(), arr.begin()));
+
+    UnrolledList<std::string> words;
+    for (int k = 0; k < 100; k++)
+        words.push_back(std::to_string(k));
+    for (auto it = words.begin(); it != words.end();)
+        it = (std::stoi(*it) % 3 != 0) ? words.erase(it) : std::next(it);
+    printf("words: size = %zd, blocks = %zd, back = %s\n",
+           words.size(),
+           words.block_count(),
+           words.back().c_str());
+
+    // the argument is an element the insert shifts out of the way
+    UnrolledList<std::string> shifted {std::string(32, 'a'), std::string(32, 'b'), "c"};
+    shifted.insert(shifted.begin(), *std::next(shifted.begin()));
+    printf("inserted its own second element: %s\n", shifted.front().c_str());
+    return 0;
+}
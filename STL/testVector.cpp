@@ -1,9 +1,11 @@
+#include "UniquePtr.hpp"
 #include "Vector.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,8 +25,8 @@ int main()
     // size=10 cap=16
     for (int i = 0; i < 16; i++)
     {                       // O(n)
-        printf("arr.push_back(%d)\n", i);
         arr.push_back(i);   // O(1)+
+        printf("arr.push_back(%d) cap=%zd\n", i, arr.capacity());
     }
     arr.insert(arr.begin() + 3, {40, 41, 42});
     for (size_t i = 0; i < arr.size(); i++)
@@ -39,4 +41,50 @@ int main()
     printf("arr.size() = %zd\n", arr.size());
     printf("bar.size() = %zd\n", bar.size());
     printf("sizeof(Vector) = %zd\n", sizeof(Vector<int>));
+
+    // UniquePtr opts into IsTriviallyRelocatable, so growth and shifting are memmoves
+    Vector<UniquePtr<int>> ptrs;
+    for (int i = 0; i < 5; i++)
+        ptrs.push_back(makeUnique<int>(i));
+    ptrs.emplace(ptrs.begin() + 1, makeUnique<int>(10));
+    ptrs.erase(ptrs.begin() + 3);
+    for (size_t i = 0; i < ptrs.size(); i++)
+        printf("*ptrs[%zd] = %d\n", i, *ptrs[i]);
+
+    // 1.5x growth, with every reallocation counted into a shared stats block
+    ReallocStats stats;
+    Vector<int, std::allocator<int>, HalfGrowth, ReallocRecorder> grown;
+    grown.observer().stats = &stats;
+    for (int i = 0; i < 1000; i++)
+        grown.push_back(i);
+    printf("reallocations=%llu bytesMoved=%llu maxCap=%llu\n",
+           (unsigned long long) stats.count.load(),
+           (unsigned long long) stats.bytesMoved.load(),
+           (unsigned long long) stats.maxCap.load());
+
+    Vector<char> buf(8, default_init);   // no zero-fill, contents are indeterminate
+    std::span<char> tail = buf.append_for_overwrite(4);
+    std::memcpy(tail.data(), "tail", tail.size());
+    printf("buf.size() = %zd\n", buf.size());
+
+    Vector<int> other = bar;
+    other.push_back(42);
+    printf("bar.count(5) = %zd, bar.contains(42) = %d, other > bar = %d\n",
+           bar.count(5),
+           bar.contains(42),
+           other > bar);
+
+    // 16-byte integers match on both halves, not on either one
+    Vector<unsigned __int128> wide(40, (unsigned __int128) 1 << 64);
+    printf("wide.count(0) = %zd, wide.count(1 << 64) = %zd\n",
+           wide.count(0),
+           wide.count((unsigned __int128) 1 << 64));
+    static_assert(noexcept(bar == other) && !noexcept(Vector<std::string>().find("")));
+
+    Vector<int> big(par, 4'000'000, 7);   // filled in chunks on ThreadPool::global()
+    Vector<int> bigCopy(par, big);
+    printf("bigCopy.size() = %zd, bigCopy == big = %d\n", bigCopy.size(), bigCopy == big);
+
+    printf("sizeof(Vector<int, ..., FixedStepGrowth<64>>) = %zd\n",
+           sizeof(Vector<int, std::allocator<int>, FixedStepGrowth<64>>));
 }